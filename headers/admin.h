@@ -4,12 +4,19 @@
 #include "user.h"
 #include "event.h"
 #include "registration.h"
+#include "event_store.h"
+#include "report_engine.h"
+#include "event_ranking.h"
+#include "registration_analytics.h"
 #include "utils.h"
+#include "metrics.h"
+#include "table_renderer.h"
 #include <vector>
 #include <fstream>
 #include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <cmath>
 
 using namespace std;
 
@@ -43,6 +50,21 @@ public:
     void displayEventStats();
     void viewRegistrationReports();
     
+    // Reports & Analytics submenu
+    void reportsMenu();
+    void exportAllEventReports();
+    void showMostPopularEvents();
+    void showNearlyFullEvents();
+    void showEmptiestUpcomingEvents();
+    void showSeatMap();
+    void auditVenueBookings();
+    void showStudentsAcrossEvents();
+    void showRegistrationVelocity();
+    void showRegistrationTimeAnalytics();
+    
+    // Data maintenance
+    void checkpointDataFiles();
+    
     // User Management
     void manageUsers();
     void addNewStudent();
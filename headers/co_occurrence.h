@@ -0,0 +1,52 @@
+#ifndef CO_OCCURRENCE_H
+#define CO_OCCURRENCE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+using namespace std;
+
+// ==================== CO-OCCURRENCE INDEX ====================
+
+// One suggested event and how many students share it with the seed events
+struct RelatedEvent {
+    string eventName;
+    int score = 0;
+};
+
+// How many students registered for both of two events, for every pair that has at least one.
+// Sparse: a row per event holding only the events it actually shares students with, so
+// memory grows with the pairs that occur, not with events². Every registration adjusts the
+// counts against the student's other events (O(their registrations)); nothing is recomputed.
+class CoOccurrenceIndex {
+public:
+    // A student with 'otherEvents' registered for / unregistered from 'eventName'
+    void addRegistration(const string& eventName, const vector<string>& otherEvents);
+    void removeRegistration(const string& eventName, const vector<string>& otherEvents);
+
+    // Drop an event's row and column (e.g. the event was deleted)
+    void removeEvent(const string& eventName);
+
+    // Move an event's row and column to its new name, counts unchanged
+    void renameEvent(const string& oldName, const string& newName);
+
+    // Students registered for both
+    int count(const string& a, const string& b) const;
+
+    // "Students who registered for these also registered for": the n events sharing the most
+    // students with the seeds (counts summed over the seeds), best first. Seeds themselves
+    // and events rejected by 'keep' are left out. Only the seeds' rows are read.
+    vector<RelatedEvent> related(const vector<string>& seeds, size_t n,
+                                 const function<bool(const string&)>& keep = nullptr) const;
+
+    void clear();
+
+private:
+    unordered_map<string, unordered_map<string, int>> rows;    // Event → event → shared students
+
+    void adjust(const string& a, const string& b, int delta);
+};
+
+#endif // CO_OCCURRENCE_H
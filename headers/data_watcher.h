@@ -0,0 +1,51 @@
+#ifndef DATA_WATCHER_H
+#define DATA_WATCHER_H
+
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <time.h>
+
+using namespace std;
+
+// ==================== DATA DIRECTORY WATCHER ====================
+
+// Notices changes to a few files in one directory, whether this program or another
+// one made them. Uses inotify (the kernel queues an event for every change, so checking
+// costs one non-blocking read); where inotify isn't available it falls back to comparing
+// each file's inode, size and modification time.
+class DataWatcher {
+public:
+    DataWatcher(const string& directory, const vector<string>& fileNames);
+    ~DataWatcher();
+
+    // A watcher owns a file descriptor, so it cannot be copied
+    DataWatcher(const DataWatcher&) = delete;
+    DataWatcher& operator=(const DataWatcher&) = delete;
+
+    // Begin watching (changes made before this are not reported). Calling it again does nothing.
+    void start();
+
+    // Names of the watched files that changed since the last call.
+    // Can report a file that was only touched; never misses one that changed.
+    vector<string> changedFiles();
+
+private:
+    // What the stat() fallback compares
+    struct Signature {
+        bool exists = false;
+        ino_t inode = 0;
+        off_t size = 0;
+        timespec modified = {};
+    };
+
+    string directory;
+    vector<string> names;
+    bool started;
+    int inotifyFd;                 // -1 when using the stat() fallback
+    vector<Signature> signatures;  // Fallback only: one per watched file
+
+    Signature signatureOf(const string& name) const;
+};
+
+#endif // DATA_WATCHER_H
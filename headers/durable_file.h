@@ -0,0 +1,76 @@
+#ifndef DURABLE_FILE_H
+#define DURABLE_FILE_H
+
+#include <string>
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+// ==================== CRASH-SAFE FILE WRITES ====================
+
+// Bytes to overwrite in place inside an existing file (no newlines)
+struct FilePatch {
+    string path;
+    long long offset;
+    string bytes;
+};
+
+// Write a file and fsync it before returning (the file is created or truncated first)
+bool writeFileDurably(const string& path, const string& contents);
+
+// fsync a directory, so renames and new files inside it survive a power cut
+bool syncDirectory(const string& directory);
+
+// Replace several files and patch others in place, as one unit.
+// Every replaced file is written to "<path>.tmp" and fsynced, then a marker file listing the
+// renames and patches is made durable, then the patches (pwrite + fsync) and renames are done
+// and the marker removed. 'files' holds (path, new contents) pairs.
+bool commitFilesAtomically(const vector<pair<string, string>>& files, const vector<FilePatch>& patches,
+                           const string& markerPath);
+
+// Finish or clean up a commit whose process died part-way (run once at start-up).
+// If the marker exists the commit had fully written its temp files: redo the patches
+// (they hold absolute bytes, so applying them twice is harmless) and finish the renames.
+// Otherwise any leftover "<path>.tmp" belongs to an unfinished commit and is removed.
+// The caller must hold the ExclusiveFileLock every commit is made under: otherwise the
+// marker or temp files could belong to another session's commit that is still running.
+void recoverInterruptedCommit(const vector<string>& paths, const string& markerPath);
+
+// An exclusive flock on a lock file, from construction until destruction.
+// Waits while another process holds it; the kernel releases it if the holder dies, so a
+// lock that is held always belongs to a live process.
+class ExclusiveFileLock {
+public:
+    explicit ExclusiveFileLock(const string& lockPath);
+    ~ExclusiveFileLock();
+
+    ExclusiveFileLock(const ExclusiveFileLock&) = delete;
+    ExclusiveFileLock& operator=(const ExclusiveFileLock&) = delete;
+
+    // False if the lock file could not be opened (e.g. its directory is missing)
+    bool held() const;
+
+private:
+    int fd;
+};
+
+// A shared flock on the same kind of lock file: any number of readers hold it together,
+// and an ExclusiveFileLock waits until all of them are gone (and the other way round).
+// Readers take it so a commit can't replace or patch files half-way through their read.
+class SharedFileLock {
+public:
+    explicit SharedFileLock(const string& lockPath);
+    ~SharedFileLock();
+
+    SharedFileLock(const SharedFileLock&) = delete;
+    SharedFileLock& operator=(const SharedFileLock&) = delete;
+
+    // False if the lock file could not be opened (reading goes ahead unlocked)
+    bool held() const;
+
+private:
+    int fd;
+};
+
+#endif // DURABLE_FILE_H
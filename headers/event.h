@@ -7,6 +7,8 @@
 
 using namespace std;
 
+class TableRenderer;
+
 // ==================== EVENT CLASS ====================
 
 class Event {
@@ -16,6 +18,9 @@ private:
     string venue;
     int capacity;
     int registeredCount;
+    int heldSeats;        // Seats on hold for students who haven't confirmed yet (never saved)
+    string startTime;     // Format: HH:MM (empty: the event takes the whole day)
+    string endTime;       // Format: HH:MM, later than startTime
 
 public:
     // Constructor
@@ -28,6 +33,9 @@ public:
     int getCapacity() const;
     int getRegisteredCount() const;
     int getAvailableSeats() const;
+    int getHeldSeats() const;
+    string getStartTime() const;
+    string getEndTime() const;
 
     // Setters
     void setEventName(const string& name);
@@ -35,8 +43,10 @@ public:
     void setVenue(const string& v);
     void setCapacity(int cap);
     void setRegisteredCount(int count);
+    void setHeldSeats(int count);
+    void setTimes(const string& start, const string& end);    // Both empty = all day
 
-    // Check if event has available seats
+    // Check if event has available seats (held seats are not available)
     bool hasAvailableSeats() const;
 
     // Increment registered count
@@ -51,6 +61,9 @@ public:
     // Display event information in table format
     void display(int index = 0) const;
 
+    // Add this event as one row of an event table (see table_renderer.h)
+    void appendTableRow(TableRenderer& table, int index) const;
+
     // Display detailed event information
     void displayDetailed(int index = 0) const;
 };
@@ -0,0 +1,35 @@
+#ifndef EVENT_INDEX_H
+#define EVENT_INDEX_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// ==================== EVENT OFFSET INDEX ====================
+
+// Where one event's line starts in events.txt
+struct EventOffset {
+    string name;
+    long long offset;    // Byte offset of the line
+};
+
+// Contents of the sidecar index file (data/events.txt.idx):
+//   #checkpoint|00000000000000000042      same sequence as the events.txt it describes
+//   Tech Fest 2025|37                     eventname|byte offset, sorted by name
+// The header has a fixed width so a checkpoint can overwrite it in place.
+string formatEventIndex(vector<EventOffset> entries, long long sequence);
+
+// Just the header line (without the newline)
+string eventIndexHeader(long long sequence);
+
+// Find one event's offset by binary search over the sorted index file.
+// Only the header and about log2(lines) lines are read - never the whole file.
+// Returns false if the index is missing or damaged; otherwise 'indexSequence' is set and
+// 'offset' is the line's offset, or -1 if the event is not in the index.
+bool lookupEventOffset(const string& indexPath, const string& name, long long& indexSequence, long long& offset);
+
+// Read the line that starts at 'offset' (one seek, no newline in the result)
+bool readLineAt(const string& path, long long offset, string& line);
+
+#endif // EVENT_INDEX_H
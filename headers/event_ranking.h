@@ -0,0 +1,44 @@
+#ifndef EVENT_RANKING_H
+#define EVENT_RANKING_H
+
+#include "event.h"
+#include <string>
+#include <vector>
+#include <functional>
+
+using namespace std;
+
+// ==================== RANKED EVENT QUERIES ====================
+
+// Registered / capacity as a percentage (0 for events without capacity)
+double occupancyPercent(const Event& event);
+
+// The k events with the highest score (or lowest, if highestFirst is false), best first.
+// Only events accepted by 'keep' are considered (all of them if keep is empty).
+// Uses a bounded heap of k entries: O(n log k) instead of sorting every event.
+vector<const Event*> selectTopEvents(const vector<Event>& events, size_t k,
+                                     const function<double(const Event&)>& score,
+                                     bool highestFirst = true,
+                                     const function<bool(const Event&)>& keep = nullptr);
+
+// The k events with the most registrations
+vector<const Event*> mostPopularEvents(const vector<Event>& events, size_t k);
+
+// Every event at least 'percent' full, fullest first
+vector<const Event*> nearlyFullEvents(const vector<Event>& events, double percent);
+
+// The k least-full events whose date falls within 'days' days from 'fromDate' (DD-MM-YYYY)
+// 'fromDate' is included and 'fromDate' + 'days' is not: days = 1 means that day only
+vector<const Event*> emptiestEventsInWindow(const vector<Event>& events, size_t k,
+                                            const string& fromDate, int days);
+
+// Day number of a DD-MM-YYYY date (days since 01-01-1970), or -1 if it can't be read
+long long dayNumber(const string& date);
+
+// The same day count from numbers already parsed (month 1-12)
+long long civilDayNumber(long long year, long long month, long long day);
+
+// The DD-MM-YYYY date of a day number (the inverse of the two above)
+string dateOfDayNumber(long long days);
+
+#endif // EVENT_RANKING_H
@@ -0,0 +1,34 @@
+#ifndef EVENT_SCHEDULE_H
+#define EVENT_SCHEDULE_H
+
+#include "event.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// ==================== EVENT SCHEDULE ====================
+
+// When an event takes place, as minutes since 01-01-1970 00:00: [start, end).
+// An event without times takes its whole day. False if the date can't be read.
+bool eventInterval(const Event& event, long long& start, long long& end);
+
+// "DD-MM-YYYY HH:MM-HH:MM", or "DD-MM-YYYY all day"
+string describeTimeSlot(const Event& event);
+
+// The key two venue names share when they are the same room (case and spaces ignored)
+string venueKey(const string& venue);
+
+// Two events booked into the same venue at overlapping times
+struct VenueConflict {
+    string venue;
+    Event first;        // The one that starts first
+    Event second;
+};
+
+// Every double booking in 'events', venue by venue and in time order.
+// One sweep per venue over the events sorted by start time, keeping the ones still running
+// in a heap ordered by end time: O(n log n + k) for n events and k conflicting pairs.
+vector<VenueConflict> auditVenueConflicts(const vector<Event>& events);
+
+#endif // EVENT_SCHEDULE_H
@@ -0,0 +1,60 @@
+#ifndef EVENT_STATS_H
+#define EVENT_STATS_H
+
+#include "event.h"
+#include <string>
+#include <unordered_map>
+
+using namespace std;
+
+// ==================== EVENT STATISTICS ====================
+
+// Totals for a group of events (all events at one venue, or on one date)
+struct StatsRollup {
+    int eventCount = 0;
+    long long capacity = 0;
+    long long registered = 0;
+};
+
+// Running aggregates over the whole event table.
+// Every change is expressed as "remove the old event, add the new one",
+// which is O(1) (a few hash map updates), so the stats never need a full re-scan.
+class EventStats {
+public:
+    // Occupancy histogram buckets: 0-9%, 10-19%, ..., 90-99%, and exactly 100% (full)
+    static const int HISTOGRAM_BUCKETS = 11;
+
+    EventStats();
+
+    // Forget everything (used before rebuilding from a freshly loaded table)
+    void clear();
+
+    // Count an event into the aggregates / take it back out again
+    void addEvent(const Event& event);
+    void removeEvent(const Event& event);
+
+    // Getters
+    int getTotalEvents() const;
+    long long getTotalCapacity() const;
+    long long getTotalRegistered() const;
+    double getOverallOccupancy() const;
+    const unordered_map<string, StatsRollup>& getVenueRollups() const;
+    const unordered_map<string, StatsRollup>& getDateRollups() const;
+    int getHistogramCount(int bucket) const;
+
+    // Which histogram bucket an event falls into
+    static int occupancyBucket(const Event& event);
+
+private:
+    int totalEvents;
+    long long totalCapacity;
+    long long totalRegistered;
+    unordered_map<string, StatsRollup> byVenue;
+    unordered_map<string, StatsRollup> byDate;
+    int histogram[HISTOGRAM_BUCKETS];
+
+    // Add (sign = +1) or subtract (sign = -1) one event from every aggregate
+    void apply(const Event& event, int sign);
+};
+
+#endif // EVENT_STATS_H
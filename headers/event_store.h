@@ -0,0 +1,328 @@
+#ifndef EVENT_STORE_H
+#define EVENT_STORE_H
+
+#include "event.h"
+#include "registration.h"
+#include "event_stats.h"
+#include "registration_loader.h"
+#include "waitlist.h"
+#include "journal.h"
+#include "data_watcher.h"
+#include "store_snapshot.h"
+#include "timer_wheel.h"
+#include "seat_map.h"
+#include "interval_tree.h"
+#include "event_schedule.h"
+#include "student_bitmap.h"
+#include "co_occurrence.h"
+#include "registration_velocity.h"
+#include "durable_file.h"
+#include "utils.h"
+#include <vector>
+#include <string>
+#include <unordered_set>
+#include <unordered_map>
+#include <future>
+#include <memory>
+#include <chrono>
+#include <functional>
+
+using namespace std;
+
+// ==================== EVENT STORE ====================
+
+// One student asking for a seat (see EventStore::admitBatch())
+struct SeatRequest {
+    string username;
+    string regDate;         // Format: DD-MM-YYYY HH:MM
+};
+
+// Answer to one SeatRequest
+struct AdmissionResult {
+    bool granted = false;
+    string reason;          // Why not, when not granted
+    string seat;            // Assigned seat when granted ("row-seat", empty if the venue has none)
+};
+
+// Single in-memory copy of the events and registrations tables, shared by Admin and Student.
+// Each data file is read once (on first use); after that every change goes through
+// one of the mutation methods below, which update the running statistics and append
+// one record per change to data/journal.txt instead of rewriting the data files.
+// A checkpoint later folds the journal into fresh data files (see checkpoint()).
+// Deleted events are hidden at once; their registrations are purged from memory in a batch.
+class EventStore {
+public:
+    // The one store used by the whole program
+    static EventStore& instance();
+
+    // Read access (loads the data file behind the table the first time it is called)
+    const vector<Event>& getEvents();
+    const vector<Registration>& getRegistrations();
+    const EventStats& getStats();
+    const Waitlist& getWaitlist();
+
+    // Fetch one event by name without loading events.txt: its offset comes from the sidecar
+    // index (data/events.txt.idx), then one line is read and the journal is applied on top.
+    // Falls back to the in-memory table when it is loaded or the index is missing or stale.
+    bool lookupEvent(const string& name, Event& found);
+
+    // One student's registrations and a duplicate check, both costing
+    // O(that student's registrations) thanks to a per-student index kept next to the table
+    vector<Registration> getRegistrationsFor(const string& username);
+    bool isRegistered(const string& username, const string& eventName);
+
+    // Immutable copy of both tables and the statistics as they are now, for long reads
+    // (reports, exports) that must see one point in time. Holding it never blocks a change:
+    // the next change simply makes the next snapshot a new version. Consecutive versions
+    // share every registration chunk that did not change, so taking one after a few changes
+    // copies a few chunks, and taking one when nothing changed copies nothing.
+    // Call from the thread that makes the changes; the snapshot itself can go to any thread.
+    shared_ptr<const StoreSnapshot> snapshot();
+
+    // The last snapshot taken (nullptr before the first one). Safe to call from any thread.
+    shared_ptr<const StoreSnapshot> publishedSnapshot() const;
+
+    // Replace a whole table at once (statistics are rebuilt, then a checkpoint is written)
+    bool saveEvents(const vector<Event>& newEvents);
+    bool saveRegistrations(const vector<Registration>& newRegistrations);
+
+    // Event changes - each one updates the statistics in O(1) and appends to the journal
+    // A capacity increase promotes waitlisted students into the new seats (listed in 'promoted');
+    // a rename moves the event's registrations, holds and waitlist along with it
+    // All three decide against other sessions' latest changes: adding a name that exists
+    // (ignoring case) or removing an event that is already gone returns false
+    bool addEvent(const Event& event);
+    bool updateEvent(size_t index, const Event& updated, vector<WaitlistEntry>* promoted = nullptr,
+                     string* problem = nullptr);
+    bool removeEvent(size_t index);    // Tombstone: hides the event, its registrations and waitlist
+
+    // Registration changes - update the event's seat count and append to the journal
+    // Unregistering hands the freed seat to the next waitlisted student in the same append
+    // Every change that takes a seat is checked (and its seat picked) with the journal
+    // locked and other sessions' records applied, so two sessions never share a seat
+    bool registerStudent(const string& username, size_t eventIndex, const string& regDate);
+    bool unregisterStudent(const string& username, const string& eventName,
+                           vector<WaitlistEntry>* promoted = nullptr);
+
+    // Register one student for several events as a single transaction.
+    // Every event is checked first (exists, not chosen twice, not already registered, has a seat,
+    // no timetable clash with the student's events or the other chosen ones);
+    // if anything fails nothing changes and the reasons are added to 'problems'.
+    // Otherwise all registrations are applied and journaled with one write.
+    bool registerBatch(const string& username, const vector<size_t>& eventIndexes,
+                       const string& regDate, vector<string>& problems);
+
+    // Many students for one event: seats are granted in request order until the event is
+    // full (skipping students it would double-book, see findScheduleClash()), and every
+    // granted registration is journaled with one write. Capacity is checked with the
+    // journal locked and other sessions' registrations applied, so sessions admitting at
+    // the same time never oversell. Returns one result per request, in the same order.
+    vector<AdmissionResult> admitBatch(const string& eventName, const vector<SeatRequest>& requests);
+
+    // Seat holds: one seat kept for a student for a few minutes while they decide.
+    // A held seat counts as taken for everyone else (Event::getHeldSeats()), in every session:
+    // holds are journaled with their expiry time and checkpointed into registrations.txt.
+    // Registering for the event by any route uses the student's own hold. Holds that are
+    // neither confirmed nor released expire by themselves (timer wheel, checked between
+    // actions) and their seats go to the waitlist.
+    // Holding again renews the hold; 'problem' says why a hold was refused.
+    bool holdSeat(const string& username, const string& eventName, int minutes, string& problem);
+    bool releaseHold(const string& username, const string& eventName);
+    bool hasHold(const string& username, const string& eventName);
+
+    // Assigned seating: events at a venue listed in data/venues.txt give every new registration
+    // a seat (Registration::getSeat()). Students registered in the same admission batch sit
+    // together when a block of that size is free; otherwise each gets the best single seat.
+    // Seats are picked from a map that includes every other session's registrations.
+    // Copies the event's seat map into 'map' (false if the venue has no numbered seats).
+    bool getSeatMap(const string& eventName, SeatMap& map);
+
+    // Events already booked into the candidate's venue at overlapping times (events without
+    // times take their whole day). Pass the name of the event being edited as 'replacing'
+    // so it doesn't clash with itself. Answered from one interval tree per venue, kept
+    // current by every event change: O(log n + k), never a scan of all events.
+    vector<Event> findVenueConflicts(const Event& candidate, const string& replacing = "");
+
+    // Timetable clash: true if 'event' overlaps in time one of the events the student is
+    // already registered for (copied into 'clash'; the earliest one if there are several).
+    // Every registration route refuses such a registration (waitlist promotions excepted).
+    // Each student's events sit in an interval tree ordered by start time, built from their
+    // own rows on first use, so a check costs O(log n) in their registrations, never a scan.
+    bool findScheduleClash(const string& username, const Event& event, Event& clash);
+
+    // Registered students as sets, for "in both / in either / only in" questions.
+    // Every student gets a dense id (handed out on first sight, never reused), and every event
+    // keeps a compressed bitmap of its students' ids (student_bitmap.h), built from the table
+    // on first use and kept current by every registration change. Combine the copies returned
+    // here with intersectWith/unionWith/subtract; studentName() turns ids back into usernames.
+    RoaringBitmap studentsOf(const string& eventName);
+    uint32_t studentId(const string& username);
+    string studentName(uint32_t id) const;
+
+    // "Students who registered for your events also registered for": the n events sharing the
+    // most students with this student's events (co_occurrence.h). Events the student already
+    // has, deleted events and full events are left out. The co-registration counts are built
+    // once from the table and then adjusted by every registration change, so a request only
+    // reads the rows of the student's own events.
+    vector<RelatedEvent> recommendEvents(const string& username, size_t n);
+
+    // How fast each event is filling up: registrations in the last 15 and 60 minutes before
+    // 'nowMinute' (see registration_velocity.h) and, at the last hour's pace, the minutes until
+    // the event is full. Only events with registrations in the last hour are listed, the ones
+    // that will fill soonest first. The per-event counters are seeded from the registration
+    // dates once and then bumped by every new registration, so the report never rereads the
+    // registration history. Unregistrations don't take anything off: the rate is of sign-ups.
+    vector<EventVelocity> registrationVelocity(long long nowMinute);
+
+    // Waitlist changes (checkpointed into registrations.txt next to the registrations)
+    // Decided against other sessions' latest changes; registering by any path also leaves the
+    // event's waitlist, and promotion skips students who are registered already
+    bool joinWaitlist(const string& username, size_t eventIndex, const string& joinDate, int priority = 0,
+                      string* problem = nullptr);
+    bool leaveWaitlist(const string& username, const string& eventName);
+
+    // Throw away the cached tables and read the files again
+    void reload();
+
+    // Pick up changes other sessions made to data/ since the last call.
+    // Cheap when nothing changed (a watcher reports changed files); otherwise only the
+    // journal records appended since the last look are applied to the loaded tables.
+    // A full reload happens only if another session checkpointed changes this one never saw.
+    // Rows can move, so call it between actions, not while holding references into the tables.
+    void refresh();
+
+    // Fold the journal into fresh data files.
+    // The tables are copied here; formatting and writing happen on the thread pool,
+    // so the caller can go on working. Returns false if a checkpoint is already running
+    // (or, when waiting, if writing failed). Also starts by itself once the journal grows
+    // past a threshold; at exit only a checkpoint already running is waited for.
+    bool checkpoint(bool waitForCompletion = false);
+
+    // Wait for a running checkpoint to finish (returns its result, true if none was running)
+    bool finishCheckpoint();
+
+    // Records in the journal that are not in the data files yet
+    size_t journalRecords() const;
+
+    // Write events.txt in the fixed-width layout from the next checkpoint on, so later
+    // checkpoints can overwrite just the changed seat counts (pwrite) instead of every line.
+    // A file that is already fixed-width stays that way.
+    void setFixedWidthEvents(bool enabled);
+
+private:
+    EventStore();
+
+    // The store is shared, so copying it would be a bug
+    EventStore(const EventStore&) = delete;
+    EventStore& operator=(const EventStore&) = delete;
+
+    vector<Event> events;
+    vector<Registration> registrations;
+    EventStats stats;
+    Waitlist waitlist;
+    Journal journal;
+    unordered_set<string> tombstones;    // Deleted events whose registrations are still in memory
+    bool orphansInMemory;                // 'registrations' may still hold rows of deleted events
+    unordered_map<string, vector<size_t>> registrationsByStudent;    // username → rows in 'registrations'
+    unordered_map<string, size_t> eventPositions;                    // event name → row in 'events'
+    bool eventsLoaded;
+    bool registrationsLoaded;            // Also covers the waitlist
+    long long eventsFileSequence;        // Checkpoint sequence of each data file when it was read
+    long long registrationsFileSequence;
+    bool journalErrorsReported;
+    DataWatcher watcher;                 // Notices when another session changes data/
+    long long lastCheckpointSequence;    // Sequence of the data files this session last wrote
+    future<bool> runningCheckpoint;      // Valid while a checkpoint is in flight
+    shared_ptr<bool> checkpointSuperseded;    // ...set if another session's files were already newer
+
+    // In-place updates of a fixed-width events.txt (see checkpoint())
+    bool fixedWidthEvents;               // Layout to use when events.txt is written
+    bool eventsFilePatchable;            // events.txt is fixed-width and row i holds events[i]
+    unordered_set<size_t> dirtyCounters; // Events whose seat count changed since the last checkpoint
+    unordered_set<size_t> dirtyRows;     // Events edited since the last checkpoint
+
+    // Read snapshots (see snapshot())
+    long long changeVersion;                          // Bumped by every change to the tables
+    unordered_set<size_t> dirtyRegistrationChunks;    // Chunks changed since the last snapshot
+    bool registrationsRebuilt;                        // Whole table replaced since the last snapshot
+    shared_ptr<const StoreSnapshot> published;        // Swapped with atomic_store/atomic_load
+
+    // Seat holds (see holdSeat())
+    struct SeatHold {
+        string username;
+        string eventName;
+        string holdDate;
+        long long expiresAt;                          // holdClock() second the hold lapses at
+        size_t timer;                                 // Handle in holdTimers
+    };
+    unordered_map<unsigned long long, SeatHold> holds;      // Hold id → hold
+    unordered_map<string, unsigned long long> holdIds;      // "username|event" → hold id
+    unsigned long long nextHoldId;
+    TimerWheel holdTimers;                                  // One tick per second of holdClock()
+
+    // Assigned seating (see getSeatMap())
+    unordered_map<string, SeatLayout> venueLayouts;    // Venue → layout, from data/venues.txt
+    bool venuesLoaded;
+    unordered_map<string, SeatMap> seatMaps;           // Event name → taken seats, built on first use
+
+    // Venue bookings (see findVenueConflicts())
+    unordered_map<string, IntervalTree> venueSchedules;    // venueKey() → event times, by event name
+    bool venueSchedulesBuilt;                              // Built from 'events' on first use
+
+    // Student timetables (see findScheduleClash()); dropped whenever an event's time may change
+    unordered_map<string, IntervalTree> studentSchedules;  // username → times of their events
+
+    // Student sets (see studentsOf())
+    unordered_map<string, uint32_t> studentIds;            // username → dense id
+    vector<string> studentNames;                           // dense id → username
+    unordered_map<string, RoaringBitmap> eventStudents;    // Event name → ids of its students
+    bool eventStudentsBuilt;                               // Built from 'registrations' on first use
+
+    // Co-registration counts (see recommendEvents())
+    CoOccurrenceIndex coRegistrations;
+    bool coRegistrationsBuilt;                             // Built from 'registrations' on first use
+
+    // Sign-up counters (see registrationVelocity())
+    unordered_map<string, RateWindow> registrationRates;   // Event name → last hour, per minute
+    bool registrationRatesBuilt;                           // Seeded from 'registrations' on first use
+
+    void ensureLoaded();
+    void ensureEventsLoaded();
+    void ensureRegistrationsLoaded();
+    SharedFileLock readDataFiles();
+    void readFileSequences();
+    void reportParseErrors(const string& fileName, const vector<ParseError>& errors);
+    void rebuildStats();
+    void indexEvents();
+    void indexRegistrations();
+    Event* findLoadedEvent(const string& name);
+    size_t findRegistration(const string& username, const string& eventName) const;
+    void addRegistration(const Registration& registration);
+    void eraseRegistration(size_t row);
+    void renameEventIndexes(const string& oldName, const string& newName);
+    void replayJournal(bool toEventsTable, bool toRegistrationsTable);
+    void applyNewRecords();
+    void applyRecord(const vector<string>& f, long long first, long long second);
+    void purgeOrphans();
+    size_t promoteFromWaitlist(Event& event, vector<WaitlistEntry>* promoted, vector<string>& records);
+    bool commit(const vector<string>& records);
+    bool commitChecked(const function<bool(vector<string>& records)>& decide);
+    void checkpointIfJournalLarge();
+    long long holdClock() const;
+    void expireHolds();
+    void placeHold(const HoldEntry& entry);
+    bool consumeHold(const string& username, const string& eventName);
+    void removeHold(unsigned long long id);
+    void moveHolds(const string& oldName, const string& newName);
+    void reapplyHolds();
+    void loadVenueLayouts();
+    SeatMap* seatMapFor(const Event& event);
+    vector<string> assignSeats(const Event& event, size_t count);
+    void scheduleEvent(const Event& event);
+    void unscheduleEvent(const Event& event);
+    IntervalTree& studentSchedule(const string& username);
+    void scheduleRegistration(const Registration& registration, bool add);
+    vector<string> otherEventsOf(const string& username, size_t exceptRow) const;
+};
+
+#endif // EVENT_STORE_H
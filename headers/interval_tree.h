@@ -0,0 +1,62 @@
+#ifndef INTERVAL_TREE_H
+#define INTERVAL_TREE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+// ==================== INTERVAL TREE ====================
+
+// Half-open intervals [start, end) with a string id each (e.g. event name and its time slot).
+// A search tree ordered by start (a treap: random priorities keep it balanced on average),
+// where every node also remembers the largest end in its subtree. A query skips every
+// subtree that ends before the query starts or starts after it ends, so finding the k
+// overlapping intervals costs O(log n + k) instead of O(n).
+class IntervalTree {
+public:
+    IntervalTree();
+
+    void insert(long long start, long long end, const string& id);
+
+    // Remove one interval added with exactly these values (false if there is none)
+    bool erase(long long start, long long end, const string& id);
+
+    // Add the id of every interval overlapping [start, end) to 'ids', in start order
+    void overlapping(long long start, long long end, vector<string>& ids) const;
+
+    // Just the overlapping interval that starts first, found on one root-to-leaf path:
+    // O(log n) however many intervals overlap. False if none does.
+    bool firstOverlapping(long long start, long long end, string& id) const;
+
+    size_t size() const;
+    void clear();
+
+private:
+    // Nodes live in one pool and point to their children by index (-1 = none)
+    struct Node {
+        long long start = 0;
+        long long end = 0;
+        long long maxEnd = 0;       // Largest end in this node's subtree
+        string id;
+        uint32_t priority = 0;      // Heap order on priorities keeps the tree balanced
+        int left = -1;
+        int right = -1;
+    };
+
+    vector<Node> nodes;
+    vector<int> freeNodes;          // Pool entries that can be reused
+    int root;
+    size_t count;
+    uint32_t seed;                  // xorshift state for priorities
+
+    bool lessThan(const Node& node, long long start, long long end, const string& id) const;
+    void update(int node);
+    void split(int node, long long start, long long end, const string& id, int& left, int& right);
+    int merge(int left, int right);
+    int eraseFrom(int node, long long start, long long end, const string& id, bool& erased);
+    void collect(int node, long long start, long long end, vector<string>& ids) const;
+};
+
+#endif // INTERVAL_TREE_H
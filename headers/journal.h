@@ -0,0 +1,98 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <functional>
+#include <sys/types.h>
+
+using namespace std;
+
+// ==================== CHANGE JOURNAL ====================
+
+// One line of the journal: "sequence|TYPE|fields..."
+struct JournalRecord {
+    long long sequence;    // 0 if the line could not be read
+    string text;           // Everything after the sequence number ("TYPE|fields...")
+};
+
+// Append-only log of changes that have not been folded into the data files yet.
+// Every record gets the next sequence number; the data files remember the last sequence
+// they contain, so replaying the journal never applies a change twice.
+// Appending costs one small write no matter how big events.txt / registrations.txt are.
+// An append returns only once its records are fsynced; appends that arrive while an fsync is
+// running are covered together by the next one (group commit), so concurrent changes share
+// one fsync. Safe to use from several threads at the same time, and from several sessions:
+// an append first reads what other sessions appended (under flock), so numbers never repeat.
+class Journal {
+public:
+    explicit Journal(const string& filePath);
+    ~Journal();
+
+    // Append records durably (several records are written with a single write)
+    bool append(const string& record);
+    bool append(const vector<string>& records);
+
+    // Append records that depend on what other sessions did (check-then-write as one step).
+    // With the file locked, 'decide' gets the records other sessions appended since the last
+    // look (they are not handed out by readNewRecords() again) and fills 'records' with what
+    // to append, possibly nothing; no session can append in between. 'decide' runs with the
+    // journal locked, so it must not call back into it. 'missed' is set, and nothing is
+    // appended, if records were checkpointed before this session read them (see readNewRecords()).
+    bool appendChecked(const function<void(const vector<JournalRecord>& caughtUp, vector<string>& records)>& decide,
+                       bool& missed);
+
+    // Every record in file order (a missing journal simply has no records)
+    vector<JournalRecord> readAll() const;
+
+    // Records other sessions appended that this one has not seen yet (numbered above the
+    // last sequence seen here when they were read), oldest first. Only the bytes added since
+    // the previous look are read. 'missed' is set if another session's checkpoint trimmed
+    // records from the journal before this session read them (the caller must reload).
+    vector<JournalRecord> readNewRecords(bool& missed);
+
+    // Remove every record up to and including 'sequence', keeping the ones after it.
+    // The shortened journal is written to a temporary file and renamed over the old one.
+    bool dropThrough(long long sequence);
+
+    // Records currently in the journal and the last sequence number handed out
+    size_t recordCount() const;
+    long long lastSequence() const;
+
+    // Used after loading: continue numbering after 'sequence' (anything read but not yet
+    // handed out by readNewRecords() is already part of what was loaded, so it is dropped)
+    void resetCounters(size_t count, long long sequence);
+
+    // How long an fsync leader waits for more appends to join its group (default: no wait)
+    void setGroupCommitWindow(chrono::microseconds window);
+
+    // fsyncs done so far (each one may cover many appends)
+    size_t syncCount() const;
+
+private:
+    string path;
+    mutable mutex fileMutex;    // One writer at a time (appends vs. checkpoint truncation)
+    condition_variable synced;  // Signalled whenever an fsync finishes
+    int fd;                     // Open for appending, -1 until the first append
+    size_t records;
+    long long last;             // Last sequence written
+    long long durable;          // Last sequence known to be on disk
+    bool syncing;               // An fsync leader is running
+    chrono::microseconds groupWindow;
+    size_t syncs;
+    ino_t readInode;            // Journal file the read position belongs to
+    long long readOffset;       // Bytes of it already read
+    vector<JournalRecord> unseen;    // Other sessions' records read but not handed out yet
+    bool missedSinceRead;            // Records were trimmed before this session read them
+
+    bool openForAppend();
+    bool lockFile(unique_lock<mutex>& lock);
+    bool writeLocked(unique_lock<mutex>& lock, const vector<string>& newRecords);
+    void catchUp();
+    bool syncThrough(unique_lock<mutex>& lock, long long sequence);
+};
+
+#endif // JOURNAL_H
@@ -0,0 +1,84 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <atomic>
+
+using namespace std;
+
+// ==================== OPERATION METRICS ====================
+// Per-operation latency and heap allocation accounting.
+// Opt-in: only active when built with "make PROFILE=1" (defines EM_PROFILE).
+// In a normal build OperationScope is an empty object and costs nothing.
+// Note: interactive operations include the time spent waiting for keyboard input.
+// Allocations made by thread pool tasks count toward the operation that submitted them
+// through a TaskGroup (see WorkerScope); a fire-and-forget task needs a scope of its own.
+
+class OperationScope {
+public:
+    // Start measuring the named operation (name must be a string literal)
+    explicit OperationScope(const char* opName);
+
+    // Stop measuring and add the results to the global metrics table
+    ~OperationScope();
+
+    // Scopes are tied to a block of code, so they cannot be copied
+    OperationScope(const OperationScope&) = delete;
+    OperationScope& operator=(const OperationScope&) = delete;
+
+#ifdef EM_PROFILE
+    // Called by the global operator new/delete hooks in metrics.cpp
+    static void recordAllocation(size_t bytes);
+    static void recordDeallocation(size_t bytes);
+
+private:
+    const char* name;
+    OperationScope* parent;                       // Enclosing scope on this thread
+    chrono::steady_clock::time_point start;
+    // Atomic: pool workers charge the operation they work for at the same time as its own thread
+    atomic<size_t> allocCount;
+    atomic<size_t> allocBytes;
+    atomic<size_t> freeCount;
+    atomic<size_t> freeBytes;
+
+    friend class WorkerScope;
+    friend OperationScope* currentOperation();
+#endif
+};
+
+// The innermost operation running on this thread (nullptr if none, or without PROFILE=1)
+OperationScope* currentOperation();
+
+// Makes a pool worker charge its allocations to another thread's operation while a task runs.
+// TaskGroup captures currentOperation() when a task is submitted and runs the task inside
+// a WorkerScope for it. That is safe because a group waits for its tasks before the scope
+// that created it can end.
+class WorkerScope {
+public:
+    explicit WorkerScope(OperationScope* owner);
+    ~WorkerScope();
+
+    WorkerScope(const WorkerScope&) = delete;
+    WorkerScope& operator=(const WorkerScope&) = delete;
+
+#ifdef EM_PROFILE
+private:
+    OperationScope* saved;    // The worker's own scope, restored afterwards
+#endif
+};
+
+// Print the collected metrics table (no-op unless built with PROFILE=1)
+void printOperationMetrics(ostream& out);
+
+#ifndef EM_PROFILE
+inline OperationScope::OperationScope(const char*) {}
+inline OperationScope::~OperationScope() {}
+inline void printOperationMetrics(ostream&) {}
+inline OperationScope* currentOperation() { return nullptr; }
+inline WorkerScope::WorkerScope(OperationScope*) {}
+inline WorkerScope::~WorkerScope() {}
+#endif
+
+#endif // METRICS_H
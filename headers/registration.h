@@ -13,15 +13,20 @@ private:
     string studentUsername;
     string eventName;
     string registrationDate;  // Format: DD-MM-YYYY HH:MM
+    string seat;              // Assigned seat "row-seat" (empty: venue without numbered seats)
 
 public:
     // Constructor
-    Registration(string username = "", string event = "", string regDate = "");
+    Registration(string username = "", string event = "", string regDate = "", string seatLabel = "");
 
     // Getters
     string getStudentUsername() const;
     string getEventName() const;
     string getRegistrationDate() const;
+    string getSeat() const;
+
+    // The event was renamed (registrations follow their event)
+    void setEventName(const string& name);
 
     // Format registration data for file storage
     string toFileFormat() const;
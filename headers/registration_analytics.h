@@ -0,0 +1,44 @@
+#ifndef REGISTRATION_ANALYTICS_H
+#define REGISTRATION_ANALYTICS_H
+
+#include "event.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+using namespace std;
+
+// ==================== REGISTRATION TIME ANALYTICS ====================
+
+// When students register, counted into time buckets
+struct RegistrationHistogram {
+    long long byHourOfDay[24] = {};              // 00:00-00:59, 01:00-01:59, ...
+    map<long long, long long> byDay;             // Day number (see event_ranking.h) → registrations
+    unordered_map<string, long long> byEvent;    // Event name → registrations
+    long long registrations = 0;
+    long long waitlistEntries = 0;               // Waitlist lines (not counted as registrations)
+    long long unreadableLines = 0;               // Lines without a readable DD-MM-YYYY HH:MM date
+};
+
+// Count every registration in a registrations.txt-format file by hour of day, day and event
+// What it does: Reads the file once, front to back, in fixed-size blocks cut at line ends,
+// so memory stays at a few blocks however large the file is (it may be larger than RAM).
+// With 'parallel', one block per worker is read at a time and the blocks are counted on the
+// shared ThreadPool; each block's counts are merged before its buffer is reused.
+// Dates go through the fixed-format parseRegistrationTime(). Returns false if the file
+// could not be opened.
+bool analyzeRegistrationTimes(const string& path, RegistrationHistogram& histogram, bool parallel = true);
+
+// One venue's registrations (the event counts added up per venue)
+struct VenueRegistrations {
+    string venue;
+    long long registrations = 0;
+};
+
+// Group the per-event counts by venue (venueKey(), so "Lab 1" and "lab 1 " are one venue),
+// busiest first. Registrations for events that no longer exist are under "(deleted events)".
+vector<VenueRegistrations> registrationsByVenue(const RegistrationHistogram& histogram,
+                                                const vector<Event>& events);
+
+#endif // REGISTRATION_ANALYTICS_H
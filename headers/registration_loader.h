@@ -0,0 +1,40 @@
+#ifndef REGISTRATION_LOADER_H
+#define REGISTRATION_LOADER_H
+
+#include "registration.h"
+#include "waitlist.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// ==================== PARALLEL REGISTRATION LOADER ====================
+
+// A line that could not be parsed (reported to the user, then skipped)
+struct ParseError {
+    size_t lineNumber;    // 1-based line number in the file
+    string text;          // The offending line
+};
+
+// A seat held for a student while they decide (see EventStore::holdSeat())
+struct HoldEntry {
+    string username;
+    string eventName;
+    string holdDate;          // Format: DD-MM-YYYY HH:MM
+    long long expiresAt = 0;  // When the hold lapses, in seconds since 1970 (time())
+
+    // Format for registrations.txt: username|eventname|holddate|HOLD|expiresat
+    string toFileFormat() const;
+};
+
+// Load registrations.txt. Lines starting with '#' (the checkpoint header) are skipped. Three kinds of lines:
+//   username|eventname|registrationdate                        (confirmed registration)
+//   username|eventname|joindate|WAITLIST|priority|sequence     (waitlist entry)
+//   username|eventname|holddate|HOLD|expiresat                 (seat hold)
+// Large files are split into newline-aligned chunks that are parsed in parallel
+// on the shared ThreadPool; the results are merged back in file order.
+// Returns false only if the file could not be opened (a missing file is not an error for callers).
+bool loadRegistrationsParallel(const string& path, vector<Registration>& out, vector<WaitlistEntry>& waitlist,
+                               vector<HoldEntry>& holds, vector<ParseError>& errors);
+
+#endif // REGISTRATION_LOADER_H
@@ -0,0 +1,49 @@
+#ifndef REGISTRATION_VELOCITY_H
+#define REGISTRATION_VELOCITY_H
+
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+// ==================== REGISTRATION VELOCITY ====================
+
+// Read a registration date "DD-MM-YYYY HH:MM" as minutes since 01-01-1970 00:00.
+// Fixed format: every field is at a known position, so the digits are turned into numbers
+// directly (no splitting, no stoi, no allocation). False if the text doesn't match.
+bool parseRegistrationTime(string_view text, long long& minute);
+
+// The current local time in the same minutes (what currentDateTime() shows)
+long long currentMinute();
+
+// Registrations per minute over the last hour, for one event.
+// A ring of 60 per-minute buckets: a registration lands in bucket (minute mod 60), and a
+// bucket still holding an older minute is reset first, so the ring never needs sweeping
+// and stays the same size however many registrations arrive.
+class RateWindow {
+public:
+    static const int MINUTES = 60;
+
+    RateWindow();
+
+    // Count 'count' registrations made in 'minute' (ignored if already out of the window)
+    void record(long long minute, int count = 1);
+
+    // Registrations in the last 'minutes' minutes up to and including 'now' (at most MINUTES)
+    int countSince(long long now, int minutes) const;
+
+private:
+    long long bucketMinute[MINUTES];    // Which minute each bucket currently counts (-1 = none)
+    int bucketCount[MINUTES];
+};
+
+// One row of the velocity report
+struct EventVelocity {
+    string eventName;
+    int lastQuarterHour = 0;        // Registrations in the last 15 minutes
+    int lastHour = 0;               // ... and in the last 60
+    int seatsLeft = 0;              // Free seats, not counting held ones
+    double minutesToFull = -1;      // At the last hour's pace (-1: no registrations lately)
+};
+
+#endif // REGISTRATION_VELOCITY_H
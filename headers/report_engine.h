@@ -0,0 +1,36 @@
+#ifndef REPORT_ENGINE_H
+#define REPORT_ENGINE_H
+
+#include "event.h"
+#include "registration.h"
+#include "store_snapshot.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// ==================== REPORT ENGINE ====================
+
+// One event's finished participant report
+struct EventReport {
+    string eventName;
+    string text;               // Whole report, ready to write in one go
+    int participantCount = 0;
+};
+
+// Build a participant report for every event, in parallel on the shared ThreadPool.
+// Reports come back in the same order as 'events'.
+// Takes snapshot tables (see EventStore::snapshot()), which the tasks can read while the
+// store goes on taking registrations.
+vector<EventReport> buildAllEventReports(const ChunkedTable<Event>& events,
+                                         const ChunkedTable<Registration>& registrations);
+
+// Write each report to its own file: <directory>/<event name>.txt
+// (names that clean up to the same file name get _2, _3, ... in report order)
+// Returns the number of files written
+int writeReportsPerEvent(const vector<EventReport>& reports, const string& directory);
+
+// Write all reports one after another into a single file
+bool writeCombinedReport(const vector<EventReport>& reports, const string& path);
+
+#endif // REPORT_ENGINE_H
@@ -0,0 +1,54 @@
+#ifndef SEAT_MAP_H
+#define SEAT_MAP_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+// ==================== SEAT MAP ====================
+
+// Numbered seating of one venue (a line of data/venues.txt)
+struct SeatLayout {
+    int rows = 0;
+    int seatsPerRow = 0;
+};
+
+// Seat labels in files and on screen are "row-seat", both counted from 1 (e.g. "3-14")
+string formatSeat(int row, int seat);
+bool parseSeat(const string& text, int& row, int& seat);
+
+// Which seats of one event are taken, for venues with numbered seats (see data/venues.txt).
+// Each row is a packed bitset (one bit per seat, 64 seats per word), so a 5,000-seat hall
+// is under 1 KB and searches work on 64 seats at a time.
+class SeatMap {
+public:
+    SeatMap(int rows = 0, int seatsPerRow = 0);
+
+    int getRows() const;
+    int getSeatsPerRow() const;
+    int getFreeSeats() const;
+
+    bool isTaken(int row, int seat) const;
+
+    // Mark a seat taken / free again (false if it is outside the map or already taken)
+    bool take(int row, int seat);
+    void release(int row, int seat);
+
+    // Best block of 'count' free seats side by side in one row: rows are tried front to back,
+    // and within a row the block closest to the centre wins. False if no row has one.
+    bool findBest(int count, int& row, int& firstSeat) const;
+
+    // One row for display: '#' taken, '.' free
+    string rowPicture(int row) const;
+
+private:
+    int rows;
+    int seatsPerRow;
+    int wordsPerRow;
+    int takenSeats;
+    vector<uint64_t> taken;    // Bit set = seat taken; row r uses words [r * wordsPerRow, (r + 1) * wordsPerRow)
+};
+
+#endif // SEAT_MAP_H
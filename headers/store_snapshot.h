@@ -0,0 +1,63 @@
+#ifndef STORE_SNAPSHOT_H
+#define STORE_SNAPSHOT_H
+
+#include "event.h"
+#include "registration.h"
+#include "event_stats.h"
+#include <vector>
+#include <memory>
+#include <unordered_set>
+
+using namespace std;
+
+// ==================== READ SNAPSHOTS ====================
+
+// Read-only copy of a table, stored as fixed-size chunks that versions share.
+// Building the next version copies only the chunks whose rows changed; every other chunk is
+// the same shared_ptr as in the previous version. Nothing inside ever changes, so any number
+// of threads can read it without locks.
+template <typename T>
+class ChunkedTable {
+public:
+    static const size_t CHUNK_ROWS = 1024;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](size_t i) const { return (*chunks[i / CHUNK_ROWS])[i % CHUNK_ROWS]; }
+
+    // Copy of 'table' that reuses every chunk of 'previous' not listed in 'dirtyChunks'
+    // (all chunks are copied if 'allDirty' is set)
+    static ChunkedTable rebuild(const ChunkedTable& previous, const vector<T>& table,
+                                const unordered_set<size_t>& dirtyChunks, bool allDirty) {
+        ChunkedTable next;
+        next.count = table.size();
+        size_t chunkCount = (table.size() + CHUNK_ROWS - 1) / CHUNK_ROWS;
+        next.chunks.reserve(chunkCount);
+        for (size_t c = 0; c < chunkCount; c = c + 1) {
+            size_t begin = c * CHUNK_ROWS;
+            size_t end = min(table.size(), begin + CHUNK_ROWS);
+            bool reusable = !allDirty && dirtyChunks.count(c) == 0 && c < previous.chunks.size() &&
+                            previous.chunks[c]->size() == end - begin;
+            if (reusable) {
+                next.chunks.push_back(previous.chunks[c]);
+            } else {
+                next.chunks.push_back(make_shared<const vector<T>>(table.begin() + begin, table.begin() + end));
+            }
+        }
+        return next;
+    }
+
+private:
+    vector<shared_ptr<const vector<T>>> chunks;
+    size_t count = 0;
+};
+
+// Both tables and the statistics as they were at one moment (see EventStore::snapshot())
+struct StoreSnapshot {
+    long long version = 0;    // Changes made to the store before this snapshot was taken
+    ChunkedTable<Event> events;
+    ChunkedTable<Registration> registrations;
+    EventStats stats;
+};
+
+#endif // STORE_SNAPSHOT_H
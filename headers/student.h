@@ -4,7 +4,10 @@
 #include "user.h"
 #include "event.h"
 #include "registration.h"
+#include "event_store.h"
 #include "utils.h"
+#include "metrics.h"
+#include "table_renderer.h"
 #include <vector>
 #include <fstream>
 #include <algorithm>
@@ -38,10 +41,12 @@ public:
     // Event Browsing
     void viewAvailableEvents();
     void viewMyRegistrations();
+    void viewRecommendedEvents();       // "Students who registered for your events also registered for"
     
     // Registration Management
     void registerForEvent();
     void unregisterFromEvent(const string& eventName);
+    void registerForMultipleEvents();    // "Cart": several events, one transaction
     
     // Search and Filter
     void searchEventByName();
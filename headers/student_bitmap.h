@@ -0,0 +1,57 @@
+#ifndef STUDENT_BITMAP_H
+#define STUDENT_BITMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// ==================== STUDENT BITMAP ====================
+
+// A set of small whole numbers (dense student ids), stored the "roaring" way:
+// ids are grouped by their upper 16 bits, and each group of up to 65,536 ids is kept as
+// either a sorted array of the lower 16 bits (few members: 2 bytes per id) or a 8 KB
+// bitset (many members: 1 bit per possible id), whichever is smaller.
+// Set operations work container by container; bitset containers are combined 64 ids per
+// machine word (AND / OR / AND NOT plus popcount), never one id at a time.
+class RoaringBitmap {
+public:
+    void add(uint32_t value);
+    bool remove(uint32_t value);    // False if it wasn't there
+    bool contains(uint32_t value) const;
+    size_t cardinality() const;
+    bool empty() const;
+
+    // In-place set algebra: keep the ids in both / in either / in this one but not 'other'
+    void intersectWith(const RoaringBitmap& other);
+    void unionWith(const RoaringBitmap& other);
+    void subtract(const RoaringBitmap& other);
+
+    // Every id, in increasing order
+    vector<uint32_t> values() const;
+
+private:
+    // Arrays hold at most this many ids; one more and a bitset is smaller
+    static const size_t ARRAY_LIMIT = 4096;
+    static const size_t BITSET_WORDS = 65536 / 64;
+
+    struct Container {
+        uint16_t key = 0;           // Upper 16 bits shared by every id in here
+        uint32_t count = 0;
+        vector<uint16_t> array;     // Sorted lower bits (array form)
+        vector<uint64_t> bits;      // BITSET_WORDS words (bitset form), empty in array form
+        bool isBitset() const { return !bits.empty(); }
+    };
+
+    vector<Container> containers;   // Sorted by key
+
+    size_t findContainer(uint16_t key) const;    // Position of 'key', or where it would go
+    static void toBitset(Container& c);
+    static void shrink(Container& c);             // Back to an array once it is small enough
+    static void intersectContainers(Container& a, const Container& b);
+    static void unionContainers(Container& a, const Container& b);
+    static void subtractContainers(Container& a, const Container& b);
+};
+
+#endif // STUDENT_BITMAP_H
@@ -0,0 +1,68 @@
+#ifndef TABLE_RENDERER_H
+#define TABLE_RENDERER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iostream>
+
+using namespace std;
+
+// ==================== TABLE RENDERER ====================
+
+// One column of a table: its title and how many characters wide it is
+// (the last column is never padded, so its width is ignored)
+struct TableColumn {
+    string title;
+    size_t width;
+};
+
+// Formats table rows into one large in-memory buffer and writes it to the stream
+// only when flush() is called (once per page), instead of flushing after every row.
+// Row layout: "  NN. cell | cell | ... | cell"
+class TableRenderer {
+public:
+    TableRenderer(ostream& output, const vector<TableColumn>& tableColumns, size_t ruleWidth);
+    ~TableRenderer();    // Flushes anything still buffered
+
+    // Table furniture
+    void header();                          // Blank line, ===, column titles, ===
+    void rule();                            // ===
+    void line(string_view text);            // Any free-form line
+
+    // Rows: beginRow, one cell() per column, endRow
+    void beginRow(int index);               // index <= 0 means "no row number"
+    void cell(string_view text);
+    void cell(long long number);
+    void endRow();
+
+    // Write the buffer to the stream and flush it
+    void flush();
+
+    // Paging shared by every event table (set from --page / --limit in main.cpp)
+    // limit = rows per page (0 = no paging), page = first page to show (1-based)
+    static void setPaging(size_t page, size_t limit);
+    static size_t getPageLimit();
+    static size_t getStartPage();
+
+private:
+    ostream& out;
+    vector<TableColumn> columns;
+    size_t ruleLength;
+    string buffer;
+    size_t cellIndex;
+
+    void appendPadded(string_view text, size_t width);
+};
+
+class Event;
+
+// Column layout of the standard event table (#, name, date, venue, cap, reg, avl)
+const vector<TableColumn>& eventTableColumns();
+
+// Print events as the standard event table, one page at a time when --limit is set.
+// Rows are numbered by their position in 'rows' (1-based) on every page.
+void renderEventTable(ostream& out, const vector<const Event*>& rows);
+void renderEventTable(ostream& out, const vector<Event>& events);
+
+#endif // TABLE_RENDERER_H
@@ -0,0 +1,84 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <condition_variable>
+#include <functional>
+
+using namespace std;
+
+// ==================== THREAD POOL ====================
+
+// A fixed set of worker threads that run submitted tasks.
+// Work-stealing: every worker has its own task deque. A worker takes tasks from the back
+// of its own deque and, when that is empty, steals from the front of another worker's deque,
+// so uneven tasks (one big event report, many tiny ones) still keep every core busy.
+class ThreadPool {
+public:
+    // Pool shared by the whole program, sized to the number of CPU cores
+    static ThreadPool& instance();
+
+    explicit ThreadPool(size_t threadCount);
+    ~ThreadPool();
+
+    // A pool owns threads, so it cannot be copied
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Queue a task (goes to the caller's own deque when called from a worker)
+    // To wait for a batch of tasks, submit them through a TaskGroup.
+    void submit(function<void()> task);
+
+    size_t size() const;
+
+private:
+    // One worker's deque; its mutex is only contended when somebody steals
+    struct WorkerQueue {
+        mutex queueMutex;
+        deque<function<void()>> tasks;
+    };
+
+    vector<unique_ptr<WorkerQueue>> queues;
+    vector<thread> workers;
+
+    mutex stateMutex;                    // Guards stopping and the sleep/wake logic
+    condition_variable taskAvailable;
+    atomic<size_t> queued;               // Tasks sitting in some deque (counted before they get there)
+    atomic<size_t> nextQueue;            // Round-robin target for submits from outside the pool
+    bool stopping;
+
+    bool takeTask(size_t self, function<void()>& task);
+    void workerLoop(size_t index);
+};
+
+// One batch of tasks on a pool, with its own completion count.
+// wait() returns once this group's tasks are done; tasks other code has on the same pool
+// (e.g. a background checkpoint) are not waited for.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool);
+
+    // Waits for any tasks still running: they may refer to the caller's locals
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void submit(function<void()> task);
+
+    // Block until every task submitted through this group has finished
+    void wait();
+
+private:
+    ThreadPool& pool;
+    mutex countMutex;
+    condition_variable allDone;
+    size_t remaining;
+};
+
+#endif // THREAD_POOL_H
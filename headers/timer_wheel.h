@@ -0,0 +1,60 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+// ==================== HIERARCHICAL TIMER WHEEL ====================
+
+// Timers that fire at a whole-numbered tick (the caller decides what a tick is).
+// Four wheels of 64 slots: the first holds timers due in the next 64 ticks, one slot per
+// tick; each following wheel covers 64 times the span of the one before, one slot per
+// turn of that wheel. A timer moves down one wheel each time its slot comes round, so
+// scheduling, cancelling and firing are all O(1) per timer no matter how many are pending;
+// nothing is ever scanned or sorted.
+class TimerWheel {
+public:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+
+    explicit TimerWheel(long long startTick = 0);
+
+    // Fire 'key' at tick 'deadline' (a deadline already reached fires on the next tick).
+    // Returns a handle for cancel(), valid until the timer fires or is cancelled.
+    size_t schedule(unsigned long long key, long long deadline);
+
+    // Stop a pending timer
+    void cancel(size_t handle);
+
+    // Move the clock forward to 'now', adding the key of every timer that fired to 'fired'
+    // (in deadline order)
+    void advance(long long now, vector<unsigned long long>& fired);
+
+    long long currentTick() const;
+    size_t pending() const;
+
+private:
+    // Timers live in one pool and are chained into their slot through prev/next indexes
+    struct Timer {
+        unsigned long long key = 0;
+        long long deadline = 0;
+        long long prev = -1;
+        long long next = -1;
+        int level = -1;
+        int slot = -1;
+    };
+
+    vector<Timer> timers;
+    vector<size_t> freeTimers;           // Pool entries that can be reused
+    long long heads[LEVELS][SLOTS];      // First timer in each slot (-1 when empty)
+    long long now;
+    size_t count;
+
+    void place(size_t handle);
+    void unlink(size_t handle);
+};
+
+#endif // TIMER_WHEEL_H
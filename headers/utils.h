@@ -23,7 +23,13 @@ bool isNumeric(const string& str);
 // Validate date format (DD-MM-YYYY)
 bool isValidDate(const string& date);
 
+// Validate time format (HH:MM, 24-hour clock)
+bool isValidTime(const string& time);
+
 // Convert string to lowercase
 string toLower(const string& str);
 
+// Current local date and time (DD-MM-YYYY HH:MM)
+string currentDateTime();
+
 #endif // UTILS_H
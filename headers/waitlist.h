@@ -0,0 +1,74 @@
+#ifndef WAITLIST_H
+#define WAITLIST_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+// ==================== WAITLIST ====================
+
+// One student waiting for a seat in a full event
+struct WaitlistEntry {
+    string username;
+    string eventName;
+    string joinDate;        // Format: DD-MM-YYYY HH:MM
+    int priority = 0;       // Higher priority is promoted first
+    long long sequence = 0; // Join order; breaks ties so equal priorities are first come, first served
+
+    // Format for registrations.txt: username|eventname|joindate|WAITLIST|priority|sequence
+    string toFileFormat() const;
+};
+
+// Per-event waitlists, each kept as a binary heap (std::push_heap / std::pop_heap).
+// Promoting the next student is O(log n); nothing ever scans a whole waitlist.
+// Leaving the waitlist is lazy: the entry is marked dead and skipped when it reaches the top.
+class Waitlist {
+public:
+    Waitlist();
+
+    // Add a student to an event's waitlist (false if they are already waiting for it)
+    bool join(const WaitlistEntry& entry);
+
+    // Remove a student from an event's waitlist (false if they weren't on it)
+    bool leave(const string& username, const string& eventName);
+
+    bool contains(const string& username, const string& eventName) const;
+
+    // Take the next student to promote for an event (false if nobody is waiting)
+    bool popNext(const string& eventName, WaitlistEntry& next);
+
+    // Number of students still waiting for an event
+    size_t waitingCount(const string& eventName) const;
+
+    // Drop a whole event's waitlist (used when the event is deleted)
+    void removeEvent(const string& eventName);
+
+    // An event was renamed: its waitlist moves to the new name, in the same order
+    void renameEvent(const string& oldName, const string& newName);
+
+    // Every live entry, in join order (used when saving the file)
+    vector<WaitlistEntry> allEntries() const;
+
+    // Every live entry for one student, in join order (reads only that student's entries)
+    vector<WaitlistEntry> entriesForUser(const string& username) const;
+
+    // Sequence number for the next student who joins
+    long long nextSequence() const;
+
+    void clear();
+
+private:
+    unordered_map<string, vector<WaitlistEntry>> heaps;    // event name → heap of entries
+    unordered_map<string, long long> live;                 // "user|event" → sequence of the live entry
+    unordered_map<string, size_t> counts;                  // event name → live entries
+    unordered_map<string, vector<WaitlistEntry>> byUser;   // username → their live entries
+    long long highestSequence;
+
+    bool isLive(const WaitlistEntry& entry) const;
+    void forgetUserEntry(const string& username, const string& eventName);
+    static string key(const string& username, const string& eventName);
+};
+
+#endif // WAITLIST_H
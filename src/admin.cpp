@@ -25,7 +25,9 @@ void Admin::displayMenu() {
     cout << "3. View Event Statistics" << endl;      // Show occupancy stats
     cout << "4. View Registration Reports" << endl;  // See who registered for what
     cout << "5. Manage Users" << endl;               // Add students, view users
-    cout << "6. Logout" << endl;                     // Exit admin panel
+    cout << "6. Reports & Analytics" << endl;        // Bulk exports and analysis
+    cout << "7. Checkpoint Data Files" << endl;      // Fold the change journal into the files
+    cout << "8. Logout" << endl;                     // Exit admin panel
     cout << "Choose an option: ";
 }
 
@@ -37,126 +39,38 @@ string Admin::getUserType() {
 }
 
 // ==================== FILE I/O OPERATIONS ====================
-// These functions handle reading and writing data to text files
-// This is how we persist data (save it permanently) without a database
+// The data lives in the shared EventStore (event_store.cpp), which reads the text files once
+// and journals every change. These methods are thin wrappers around it.
 
-// Load events from file into vector
-// What it does: Reads events.txt and creates Event objects from the data
+// Load events
+// What it does: Returns a copy of the events table (the store reads events.txt on first use)
 // Returns: Vector (dynamic array) containing all Event objects
 vector<Event> Admin::loadEventsFromFile() {
-    vector<Event> events;              // Create empty vector to store events
-    ifstream file("data/events.txt");  // Open file for reading (ifstream = input file stream)
-    string line;                       // Variable to store each line
-    
-    // Check if file opened successfully
-    if (!file.is_open()) {
-        cout << "Error: Could not open events.txt file!" << endl;
-        return events;    // Return empty vector
-    }
-    
-    // Read file line by line
-    while (getline(file, line)) {
-        if (line.empty()) continue;    // Skip empty lines
-        
-        // Split the line by pipe (|) delimiter
-        // File format: eventname|date|venue|capacity|registered
-        vector<string> parts = split(line, '|');
-        
-        // Make sure we have at least 4 parts (registered count is optional)
-        if (parts.size() >= 4) {
-            // Extract and clean each field
-            string name = trim(parts[0]);
-            string date = trim(parts[1]);
-            string venue = trim(parts[2]);
-            int capacity = static_cast<int>(stoi(trim(parts[3])));  // stoi = "string to integer"
-            
-            // Ternary operator: (condition ? if_true : if_false)
-            // If there's a 5th part, use it; otherwise use 0
-            int registered = (parts.size() > 4) ? static_cast<int>(stoi(trim(parts[4]))) : 0;
-            
-            // Create Event object and add it to the vector
-            // push_back() adds an element to the end of the vector
-            events.push_back(Event(name, date, venue, capacity, registered));
-        }
-    }
-    
-    file.close();    // Always close files when done
-    return events;   // Return vector containing all events
+    OperationScope scope("Admin::loadEventsFromFile");
+    return EventStore::instance().getEvents();
 }
 
-// Save events to file
-// What it does: Writes all Event objects back to events.txt
+// Save events
+// What it does: Replaces the whole events table and writes it to events.txt
 // Parameters: 'const vector<Event>&' means we pass by reference (efficient) and won't modify it
 // Returns: true if successful, false if error
 bool Admin::saveEventsToFile(const vector<Event>& events) {
-    ofstream file("data/events.txt");  // Open file for writing (ofstream = output file stream)
-    
-    // Check if file opened successfully
-    if (!file.is_open()) {
-        cout << "Error: Could not open events.txt for writing!" << endl;
-        return false;
-    }
-    
-    // Write each event to the file
-    for (size_t i = 0; i < events.size(); i = i + 1) {
-        file << events[i].toFileFormat() << endl;
-    }
-    
-    file.close();    // Always close files when done
-    return true;     // Indicate success
+    OperationScope scope("Admin::saveEventsToFile");
+    return EventStore::instance().saveEvents(events);
 }
 
-// Load registrations from file
-// What it does: Reads registrations.txt and creates Registration objects
-// Similar to loadEventsFromFile but for registrations
-// Returns: Vector of Registration objects
+// Load registrations
+// What it does: Returns a copy of the registrations table
 vector<Registration> Admin::loadRegistrationsFromFile() {
-    vector<Registration> registrations;      // Empty vector to store registrations
-    ifstream file("data/registrations.txt"); // Open registrations file
-    string line;
-    
-    // If file doesn't exist or can't open, return empty vector (not an error)
-    if (!file.is_open()) {
-        return registrations;
-    }
-    
-    // Read each line from the file
-    while (getline(file, line)) {
-        if (line.empty()) continue;    // Skip empty lines
-        
-        // Split by pipe delimiter
-        // File format: username|eventname|registrationdate
-        vector<string> parts = split(line, '|');
-        
-        // Must have exactly 3 parts
-        if (parts.size() == 3) {
-            // Create Registration object and add to vector
-            registrations.push_back(Registration(trim(parts[0]), trim(parts[1]), trim(parts[2])));
-        }
-    }
-    
-    file.close();
-    return registrations;
+    OperationScope scope("Admin::loadRegistrationsFromFile");
+    return EventStore::instance().getRegistrations();
 }
 
-// Save registrations to file
-// What it does: Writes all Registration objects back to registrations.txt
-// Called after: A student registers or unregisters from an event
+// Save registrations
+// What it does: Replaces the whole registrations table and writes it to registrations.txt
 bool Admin::saveRegistrationsToFile(const vector<Registration>& registrations) {
-    ofstream file("data/registrations.txt");  // Open for writing
-    
-    if (!file.is_open()) {
-        cout << "Error: Could not open registrations.txt for writing!" << endl;
-        return false;
-    }
-    
-    // Write each registration to file
-    for (size_t i = 0; i < registrations.size(); i = i + 1) {
-        file << registrations[i].toFileFormat() << endl;
-    }
-    
-    file.close();
-    return true;
+    OperationScope scope("Admin::saveRegistrationsToFile");
+    return EventStore::instance().saveRegistrations(registrations);
 }
 
 // ==================== EVENT MANAGEMENT MENU ====================
@@ -201,14 +115,62 @@ void Admin::manageEvents() {
     }
 }
 
+// Ask for an event's start and end time
+// What it does: A blank start time means the event takes the whole day; otherwise both
+// times must be HH:MM and the end must come after the start (events don't run past midnight)
+static bool readEventTimes(string& start, string& end) {
+    cout << "Start time (HH:MM, blank for all day): ";
+    getline(cin, start);
+    start = trim(start);
+    if (start.empty()) {
+        end = "";
+        return true;
+    }
+    cout << "End time (HH:MM): ";
+    getline(cin, end);
+    end = trim(end);
+    if (!isValidTime(start) || !isValidTime(end)) {
+        cout << "Error: Invalid time format! Use HH:MM (24-hour)." << endl;
+        return false;
+    }
+    if (end <= start) {
+        cout << "Error: End time must be after start time!" << endl;
+        return false;
+    }
+    return true;
+}
+
+// Is there an event with this name (ignoring case), as the store sees it now?
+// Used to explain a refused change: the store has just caught up with other sessions
+static bool eventNameExists(const string& name) {
+    const vector<Event>& events = EventStore::instance().getEvents();
+    for (size_t i = 0; i < events.size(); i = i + 1) {
+        if (toLower(events[i].getEventName()) == toLower(name)) return true;
+    }
+    return false;
+}
+
+// Tell the admin which bookings clash with an event (true if there are any)
+static bool reportVenueConflicts(const Event& event, const string& replacing) {
+    vector<Event> conflicts = EventStore::instance().findVenueConflicts(event, replacing);
+    if (conflicts.empty()) return false;
+    cout << "Error: " << event.getVenue() << " is already booked at that time by:" << endl;
+    for (size_t i = 0; i < conflicts.size(); i = i + 1) {
+        cout << "  - " << conflicts[i].getEventName() << " (" << describeTimeSlot(conflicts[i]) << ")" << endl;
+    }
+    return true;
+}
+
 // Add new event (CREATE operation)
 // What it does: Gets event details from admin and adds it to the system
-// Input validation: Checks for empty fields, duplicate names, valid date format
+// Input validation: Checks for empty fields, duplicate names, valid date and time format,
+// and that the venue is not already booked at that time
 void Admin::addNewEvent() {
+    OperationScope scope("Admin::addNewEvent");
     cout << "\n=== ADD NEW EVENT ===" << endl;
     
     // Declare variables to store event details
-    string eventName, date, venue;
+    string eventName, date, venue, startTime, endTime;
     int capacity;
     
     // Get event name
@@ -223,7 +185,8 @@ void Admin::addNewEvent() {
     }
     
     // Check for duplicate event names
-    vector<Event> events = loadEventsFromFile();  // Load existing events
+    EventStore& store = EventStore::instance();
+    const vector<Event>& events = store.getEvents();  // Existing events (shared, not copied)
     for (size_t i = 0; i < events.size(); i = i + 1) {
         // Case-insensitive comparison using toLower()
         if (toLower(events[i].getEventName()) == toLower(eventName)) {
@@ -253,6 +216,9 @@ void Admin::addNewEvent() {
         return;
     }
     
+    // Get and validate the time slot
+    if (!readEventTimes(startTime, endTime)) return;
+    
     // Get and validate capacity
     cout << "Capacity: ";
     int cap_input;
@@ -265,13 +231,19 @@ void Admin::addNewEvent() {
     
     capacity = static_cast<int>(cap_input);
     
-    // All validations passed - add new event to vector
     // Last parameter (0) means 0 students registered initially
-    events.push_back(Event(eventName, date, venue, capacity, 0));
+    Event event(eventName, date, venue, capacity, 0);
+    event.setTimes(startTime, endTime);
+    
+    // Refuse to double-book the venue
+    if (reportVenueConflicts(event, "")) return;
     
-    // Save updated vector back to file
-    if (saveEventsToFile(events)) {
+    // All validations passed - add new event to the store (which saves events.txt)
+    // The store checks the name again against other sessions' latest changes
+    if (store.addEvent(event)) {
         cout << "\nSuccess! Event '" << eventName << "' added successfully!" << endl;
+    } else if (eventNameExists(eventName)) {
+        cout << "Error: Event with this name already exists (added by another session)!" << endl;
     } else {
         cout << "Error: Failed to save event!" << endl;
     }
@@ -279,9 +251,11 @@ void Admin::addNewEvent() {
 
 // Edit event
 void Admin::editEvent() {
+    OperationScope scope("Admin::editEvent");
     cout << "\n=== EDIT EVENT ===" << endl;
     
-    vector<Event> events = loadEventsFromFile();
+    EventStore& store = EventStore::instance();
+    const vector<Event>& events = store.getEvents();
     if (events.empty()) {
         cout << "No events to edit!" << endl;
         return;
@@ -299,14 +273,16 @@ void Admin::editEvent() {
         return;
     }
     
-    Event& event = events[eventNum - 1];
+    // Work on a copy; the store swaps it in (and updates its statistics) when we save
+    Event event = events[eventNum - 1];
     
     cout << "\nEditing: " << event.getEventName() << endl;
     cout << "1. Edit Name" << endl;
     cout << "2. Edit Date" << endl;
     cout << "3. Edit Venue" << endl;
     cout << "4. Edit Capacity" << endl;
-    cout << "5. Done" << endl;
+    cout << "5. Edit Time" << endl;
+    cout << "6. Done" << endl;
     cout << "Choose option: ";
     
     int choice;
@@ -370,9 +346,11 @@ void Admin::editEvent() {
             cout << "New capacity: ";
             cin >> newCap_input;
             
-            if (newCap_input < 0 || static_cast<int>(newCap_input) < event.getRegisteredCount()) {
-                cout << "Error: New capacity cannot be less than registered count (" 
-                     << event.getRegisteredCount() << ")!" << endl;
+            // Checked again when saving, against the seats other sessions have taken by then
+            int taken = event.getRegisteredCount() + event.getHeldSeats();
+            if (newCap_input < 0 || static_cast<int>(newCap_input) < taken) {
+                cout << "Error: New capacity cannot be less than registered and held seats (" 
+                     << taken << ")!" << endl;
             } else if (newCap_input > 0) {
                 event.setCapacity(static_cast<int>(newCap_input));
                 cout << "Capacity updated successfully!" << endl;
@@ -381,16 +359,38 @@ void Admin::editEvent() {
             }
             break;
         }
-        case 5:
+        case 5: {
+            string newStart, newEnd;
+            if (readEventTimes(newStart, newEnd)) {
+                event.setTimes(newStart, newEnd);
+                cout << "Time updated successfully!" << endl;
+            }
+            break;
+        }
+        case 6:
             break;
         default:
             cout << "Invalid choice!" << endl;
             return;
     }
     
-    if (choice >= 1 && choice <= 4) {
-        if (saveEventsToFile(events)) {
+    // A new date, venue or time must not double-book the venue
+    if ((choice == 2 || choice == 3 || choice == 5) && reportVenueConflicts(event, events[eventNum - 1].getEventName())) {
+        cout << "Changes were not saved." << endl;
+        return;
+    }
+    
+    if (choice >= 1 && choice <= 5) {
+        // A bigger capacity promotes waitlisted students into the new seats automatically
+        vector<WaitlistEntry> promoted;
+        string problem;
+        if (store.updateEvent(eventNum - 1, event, &promoted, &problem)) {
             cout << "Changes saved successfully!" << endl;
+            for (size_t i = 0; i < promoted.size(); i = i + 1) {
+                cout << "Promoted from waitlist: " << promoted[i].username << endl;
+            }
+        } else if (!problem.empty()) {
+            cout << "Error: " << problem << "! Changes were not saved." << endl;
         } else {
             cout << "Error: Failed to save changes!" << endl;
         }
@@ -399,9 +399,11 @@ void Admin::editEvent() {
 
 // Delete event
 void Admin::deleteEvent() {
+    OperationScope scope("Admin::deleteEvent");
     cout << "\n=== DELETE EVENT ===" << endl;
     
-    vector<Event> events = loadEventsFromFile();
+    EventStore& store = EventStore::instance();
+    const vector<Event>& events = store.getEvents();
     if (events.empty()) {
         cout << "No events to delete!" << endl;
         return;
@@ -420,32 +422,20 @@ void Admin::deleteEvent() {
     }
     
     cout << "\nDeleting: " << events[eventNum - 1].getEventName() << endl;
-    cout << "This will also remove all registrations for this event!" << endl;
+    cout << "This will also remove all registrations and the waitlist for this event!" << endl;
     cout << "Are you sure? (yes/no): ";
     
     string confirmation;
     getline(cin, confirmation);
     
     if (toLower(trim(confirmation)) == "yes") {
-        string deletedEventName = events[eventNum - 1].getEventName();
-        events.erase(events.begin() + eventNum - 1);
-        
-        if (saveEventsToFile(events)) {
-            vector<Registration> registrations = loadRegistrationsFromFile();
-            vector<Registration> updatedRegistrations;
-            
-            // Loop through all registrations and keep only those not matching the deleted event
-            for (size_t i = 0; i < registrations.size(); i = i + 1) {
-                if (registrations[i].getEventName() != deletedEventName) {
-                    updatedRegistrations.push_back(registrations[i]);
-                }
-            }
-            
-            // Replace the original vector with the filtered one
-            registrations = updatedRegistrations;
-            saveRegistrationsToFile(registrations);
-            
+        // The store hides the event and its registrations at once (tombstone in the journal);
+        // the data files are cleaned up by the next checkpoint
+        string eventName = events[eventNum - 1].getEventName();
+        if (store.removeEvent(eventNum - 1)) {
             cout << "Event deleted successfully!" << endl;
+        } else if (!eventNameExists(eventName)) {
+            cout << "Error: Event was already deleted or renamed by another session!" << endl;
         } else {
             cout << "Error: Failed to delete event!" << endl;
         }
@@ -456,7 +446,8 @@ void Admin::deleteEvent() {
 
 // Admin functionality: Read and display events from file
 void Admin::viewAllEvents() {
-    vector<Event> events = loadEventsFromFile();
+    OperationScope scope("Admin::viewAllEvents");
+    const vector<Event>& events = EventStore::instance().getEvents();
     
     cout << "\n=== ALL EVENTS ===" << endl;
     
@@ -465,44 +456,76 @@ void Admin::viewAllEvents() {
         return;
     }
     
-    cout << "\n" << string(110, '=') << endl;
-    cout << "  " << left << setw(2) << "#" << "  "
-         << setw(25) << "EVENT NAME" << " | "
-         << setw(12) << "DATE" << " | "
-         << setw(20) << "VENUE" << " | "
-         << setw(4) << "CAP" << " | "
-         << setw(4) << "REG" << " | "
-         << "AVL" << endl;
-    cout << string(110, '=') << endl;
-    
-    for (size_t i = 0; i < events.size(); i++) {
-        events[i].display(i + 1);
-    }
-    cout << string(110, '=') << endl;
+    // Header, rows and footer are buffered and flushed once (per page with --limit)
+    renderEventTable(cout, events);
     cout << "Total events: " << events.size() << endl << endl;
 }
 
 // Display event statistics
+// What it does: Prints totals, per-venue and per-date rollups and an occupancy histogram
+// The store keeps these numbers up to date on every change, so nothing is re-added here
+// Only the events table is needed: no snapshot, so registrations.txt is never read for this
+// (nothing changes the store while this runs, so the totals and the breakdown still agree)
 void Admin::displayEventStats() {
-    vector<Event> events = loadEventsFromFile();
-    vector<Registration> registrations = loadRegistrationsFromFile();
+    OperationScope scope("Admin::displayEventStats");
+    EventStore& store = EventStore::instance();
+    const EventStats& stats = store.getStats();
+    const vector<Event>& events = store.getEvents();
     
     cout << "\n=== EVENT STATISTICS ===" << endl;
     
-    size_t totalEvents = events.size();
-    int totalCapacity = 0;
-    int totalRegistered = 0;
+    cout << "Total Events: " << stats.getTotalEvents() << endl;
+    cout << "Total Capacity: " << stats.getTotalCapacity() << endl;
+    cout << "Total Registrations: " << stats.getTotalRegistered() << endl;
+    cout << "Overall Occupancy: " << fixed << setprecision(1) 
+         << stats.getOverallOccupancy() << "%" << endl;
+    
+    // Rollups are stored in hash maps (no order), so sort the keys just for display
+    // Dates are sorted by YYYYMMDD so they come out in calendar order
+    vector<pair<string, StatsRollup>> venues(stats.getVenueRollups().begin(), stats.getVenueRollups().end());
+    sort(venues.begin(), venues.end(), [](const pair<string, StatsRollup>& a, const pair<string, StatsRollup>& b) {
+        return a.first < b.first;
+    });
+    vector<pair<string, StatsRollup>> dates(stats.getDateRollups().begin(), stats.getDateRollups().end());
+    sort(dates.begin(), dates.end(), [](const pair<string, StatsRollup>& a, const pair<string, StatsRollup>& b) {
+        string keyA = a.first.size() == 10 ? a.first.substr(6, 4) + a.first.substr(3, 2) + a.first.substr(0, 2) : a.first;
+        string keyB = b.first.size() == 10 ? b.first.substr(6, 4) + b.first.substr(3, 2) + b.first.substr(0, 2) : b.first;
+        return keyA < keyB;
+    });
+    
+    cout << "\nBy Venue:" << endl;
+    cout << "-------------------------------------------" << endl;
+    for (size_t i = 0; i < venues.size(); i = i + 1) {
+        const StatsRollup& r = venues[i].second;
+        cout << venues[i].first << ": " << r.eventCount << " event(s), " << r.registered
+             << "/" << r.capacity << " (" << fixed << setprecision(1)
+             << (r.capacity > 0 ? (r.registered * 100.0 / r.capacity) : 0) << "%)" << endl;
+    }
     
-    for (size_t i = 0; i < events.size(); i = i + 1) {
-        totalCapacity = totalCapacity + events[i].getCapacity();
-        totalRegistered = totalRegistered + events[i].getRegisteredCount();
+    cout << "\nBy Date:" << endl;
+    cout << "-------------------------------------------" << endl;
+    for (size_t i = 0; i < dates.size(); i = i + 1) {
+        const StatsRollup& r = dates[i].second;
+        cout << dates[i].first << ": " << r.eventCount << " event(s), " << r.registered
+             << "/" << r.capacity << " (" << fixed << setprecision(1)
+             << (r.capacity > 0 ? (r.registered * 100.0 / r.capacity) : 0) << "%)" << endl;
     }
     
-    cout << "Total Events: " << totalEvents << endl;
-    cout << "Total Capacity: " << totalCapacity << endl;
-    cout << "Total Registrations: " << totalRegistered << endl;
-    cout << "Overall Occupancy: " << fixed << setprecision(1) 
-         << (totalCapacity > 0 ? (totalRegistered * 100.0 / totalCapacity) : 0) << "%" << endl;
+    // Histogram: one row per 10% band, plus a final row for completely full events
+    // Bars are scaled so the biggest bucket is 40 characters wide
+    int maxBucket = 1;
+    for (int b = 0; b < EventStats::HISTOGRAM_BUCKETS; b = b + 1) {
+        maxBucket = max(maxBucket, stats.getHistogramCount(b));
+    }
+    cout << "\nOccupancy Histogram:" << endl;
+    cout << "-------------------------------------------" << endl;
+    for (int b = 0; b < EventStats::HISTOGRAM_BUCKETS; b = b + 1) {
+        string label = (b == EventStats::HISTOGRAM_BUCKETS - 1)
+            ? "100%" : (to_string(b * 10) + "-" + to_string(b * 10 + 9) + "%");
+        int count = stats.getHistogramCount(b);
+        cout << right << setw(7) << label << left << " | "
+             << string(count * 40 / maxBucket, '#') << " " << count << endl;
+    }
     
     cout << "\nEvent-wise Breakdown:" << endl;
     cout << "-------------------------------------------" << endl;
@@ -510,16 +533,19 @@ void Admin::displayEventStats() {
         cout << events[i].getEventName() << ": " << events[i].getRegisteredCount() 
              << "/" << events[i].getCapacity() << " (" << fixed << setprecision(1)
              << (events[i].getCapacity() > 0 ? (events[i].getRegisteredCount() * 100.0 / events[i].getCapacity()) : 0) 
-             << "%)" << endl;
+             << "%)" << '\n';    // '\n' instead of endl: one flush at the end, not one per event
     }
+    cout << flush;
 }
 
 // View registration reports
 void Admin::viewRegistrationReports() {
+    OperationScope scope("Admin::viewRegistrationReports");
     cout << "\n=== REGISTRATION REPORTS ===" << endl;
     
-    vector<Event> events = loadEventsFromFile();
-    vector<Registration> registrations = loadRegistrationsFromFile();
+    shared_ptr<const StoreSnapshot> view = EventStore::instance().snapshot();
+    const ChunkedTable<Event>& events = view->events;
+    const ChunkedTable<Registration>& registrations = view->registrations;
     
     if (events.empty()) {
         cout << "No events in the system!" << endl;
@@ -554,7 +580,7 @@ void Admin::viewRegistrationReports() {
             if (registrations[j].getEventName() == eventName) {
                 count = count + 1;
                 cout << "  " << count << ". " << registrations[j].getStudentUsername() 
-                     << " (Registered: " << registrations[j].getRegistrationDate() << ")" << endl;
+                     << " (Registered: " << registrations[j].getRegistrationDate() << ")" << '\n';
             }
         }
         
@@ -568,6 +594,439 @@ void Admin::viewRegistrationReports() {
     }
 }
 
+// Reports & Analytics submenu
+// What it does: Groups the heavier, whole-system reports in one place
+void Admin::reportsMenu() {
+    cout << "\n=== REPORTS & ANALYTICS ===" << endl;
+    cout << "1. Export All Event Reports" << endl;
+    cout << "2. Most Popular Events (Top K)" << endl;
+    cout << "3. Nearly Full Events" << endl;
+    cout << "4. Emptiest Upcoming Events" << endl;
+    cout << "5. Seat Map of an Event" << endl;
+    cout << "6. Venue Double-Booking Audit" << endl;
+    cout << "7. Students Across Events (all / any / only / none)" << endl;
+    cout << "8. Registration Velocity (sell-out forecast)" << endl;
+    cout << "9. Registration Time Analytics (by hour / day / event / venue)" << endl;
+    cout << "10. Back" << endl;
+    cout << "Choose option: ";
+    
+    int choice;
+    cin >> choice;
+    cin.ignore();
+    
+    switch (choice) {
+        case 1:
+            exportAllEventReports();
+            break;
+        case 2:
+            showMostPopularEvents();
+            break;
+        case 3:
+            showNearlyFullEvents();
+            break;
+        case 4:
+            showEmptiestUpcomingEvents();
+            break;
+        case 5:
+            showSeatMap();
+            break;
+        case 6:
+            auditVenueBookings();
+            break;
+        case 7:
+            showStudentsAcrossEvents();
+            break;
+        case 8:
+            showRegistrationVelocity();
+            break;
+        case 9:
+            showRegistrationTimeAnalytics();
+            break;
+        case 10:
+            break;
+        default:
+            cout << "Invalid choice!" << endl;
+    }
+}
+
+// Ask for a whole number, using 'fallback' when the answer is empty or not a number
+static int readNumber(const string& prompt, int fallback) {
+    cout << prompt;
+    string answer;
+    getline(cin, answer);
+    answer = trim(answer);
+    if (answer.empty() || !isNumeric(answer) || answer.size() > 9) return fallback;
+    return stoi(answer);
+}
+
+// The K events with the most registrations (heap selection, see event_ranking.cpp)
+void Admin::showMostPopularEvents() {
+    OperationScope scope("Admin::showMostPopularEvents");
+    cout << "\n=== MOST POPULAR EVENTS ===" << endl;
+    
+    const vector<Event>& events = EventStore::instance().getEvents();
+    if (events.empty()) {
+        cout << "No events in the system!" << endl;
+        return;
+    }
+    
+    int k = readNumber("How many events? (default 10): ", 10);
+    renderEventTable(cout, mostPopularEvents(events, static_cast<size_t>(max(k, 1))));
+}
+
+// Every event at or above an occupancy threshold, fullest first
+void Admin::showNearlyFullEvents() {
+    OperationScope scope("Admin::showNearlyFullEvents");
+    cout << "\n=== NEARLY FULL EVENTS ===" << endl;
+    
+    const vector<Event>& events = EventStore::instance().getEvents();
+    int percent = readNumber("Minimum occupancy in % (default 90): ", 90);
+    vector<const Event*> rows = nearlyFullEvents(events, percent);
+    if (rows.empty()) {
+        cout << "No events are at least " << percent << "% full." << endl;
+        return;
+    }
+    renderEventTable(cout, rows);
+}
+
+// The least-full events taking place in the next N days (default: next week)
+void Admin::showEmptiestUpcomingEvents() {
+    OperationScope scope("Admin::showEmptiestUpcomingEvents");
+    cout << "\n=== EMPTIEST UPCOMING EVENTS ===" << endl;
+    
+    const vector<Event>& events = EventStore::instance().getEvents();
+    int days = readNumber("Look ahead how many days? (default 7): ", 7);
+    int k = readNumber("How many events? (default 10): ", 10);
+    
+    string today = currentDateTime().substr(0, 10);
+    vector<const Event*> rows = emptiestEventsInWindow(events, static_cast<size_t>(max(k, 1)), today, days);
+    if (rows.empty()) {
+        cout << "No events in the next " << days << " day(s)." << endl;
+        return;
+    }
+    renderEventTable(cout, rows);
+}
+
+// Taken and free seats of one event, row by row ('#' taken, '.' free)
+void Admin::showSeatMap() {
+    OperationScope scope("Admin::showSeatMap");
+    cout << "\n=== SEAT MAP ===" << endl;
+    
+    EventStore& store = EventStore::instance();
+    const vector<Event>& events = store.getEvents();
+    if (events.empty()) {
+        cout << "No events in the system!" << endl;
+        return;
+    }
+    viewAllEvents();
+    int choice = readNumber("Enter event number: ", 0);
+    if (choice < 1 || choice > (int)events.size()) {
+        cout << "Invalid selection!" << endl;
+        return;
+    }
+    
+    string eventName = events[choice - 1].getEventName();
+    SeatMap map;
+    if (!store.getSeatMap(eventName, map)) {
+        cout << "'" << eventName << "' is at a venue without numbered seats." << endl;
+        return;
+    }
+    cout << "\n" << eventName << " - " << map.getFreeSeats() << " of "
+         << map.getRows() * map.getSeatsPerRow() << " seats free (front row first)" << endl;
+    for (int r = 1; r <= map.getRows(); r = r + 1) {
+        cout << right << setw(4) << r << left << " | " << map.rowPicture(r) << '\n';
+    }
+    cout << flush;
+}
+
+// Every pair of events booked into the same venue at overlapping times
+// (e.g. entered before conflict checks existed, or by two admins at once)
+void Admin::auditVenueBookings() {
+    OperationScope scope("Admin::auditVenueBookings");
+    cout << "\n=== VENUE DOUBLE-BOOKING AUDIT ===" << endl;
+    
+    vector<VenueConflict> conflicts = auditVenueConflicts(EventStore::instance().getEvents());
+    if (conflicts.empty()) {
+        cout << "No venue is double-booked." << endl;
+        return;
+    }
+    for (size_t i = 0; i < conflicts.size(); i = i + 1) {
+        const VenueConflict& c = conflicts[i];
+        cout << c.venue << ": '" << c.first.getEventName() << "' (" << describeTimeSlot(c.first) << ") overlaps '"
+             << c.second.getEventName() << "' (" << describeTimeSlot(c.second) << ")" << '\n';
+    }
+    cout << conflicts.size() << " conflicting pair(s) found." << endl;
+}
+
+// Usernames of every student account in users.txt
+static vector<string> loadStudentUsernames() {
+    vector<string> students;
+    ifstream file("data/users.txt");
+    string line;
+    while (getline(file, line)) {
+        vector<string> parts = split(line, ',');
+        if (parts.size() >= 4 && toLower(trim(parts[3])) == "student") students.push_back(trim(parts[0]));
+    }
+    return students;
+}
+
+// Set questions over registrations, answered with the per-event student bitmaps
+// What it does: "registered for all of these", "for any of these", "for the first one but
+// none of the others" and "for no event at all" each combine a few bitmaps (whole machine
+// words at a time) instead of comparing registration lists with nested loops.
+void Admin::showStudentsAcrossEvents() {
+    OperationScope scope("Admin::showStudentsAcrossEvents");
+    cout << "\n=== STUDENTS ACROSS EVENTS ===" << endl;
+    cout << "1. Registered for ALL of the chosen events" << endl;
+    cout << "2. Registered for ANY of the chosen events" << endl;
+    cout << "3. Registered for the FIRST chosen event but none of the others" << endl;
+    cout << "4. Registered for no event at all" << endl;
+    int mode = readNumber("Choose option: ", 0);
+    if (mode < 1 || mode > 4) {
+        cout << "Invalid choice!" << endl;
+        return;
+    }
+    
+    EventStore& store = EventStore::instance();
+    const vector<Event>& events = store.getEvents();
+    RoaringBitmap result;
+    if (mode == 4) {
+        // Every student account, minus everybody registered for something
+        vector<string> students = loadStudentUsernames();
+        for (size_t i = 0; i < students.size(); i = i + 1) {
+            result.add(store.studentId(students[i]));
+        }
+        RoaringBitmap registered;
+        for (size_t i = 0; i < events.size(); i = i + 1) {
+            registered.unionWith(store.studentsOf(events[i].getEventName()));
+        }
+        result.subtract(registered);
+    } else {
+        if (events.empty()) {
+            cout << "No events in the system!" << endl;
+            return;
+        }
+        viewAllEvents();
+        cout << "Enter event numbers separated by spaces or commas: ";
+        string line;
+        getline(cin, line);
+        for (char& c : line) {
+            if (c == ',') c = ' ';
+        }
+        vector<string> chosen;
+        vector<string> parts = split(line, ' ');
+        for (size_t i = 0; i < parts.size(); i = i + 1) {
+            string part = trim(parts[i]);
+            if (part.empty()) continue;
+            if (!isNumeric(part) || part.size() > 9 || stoi(part) < 1 || stoi(part) > (int)events.size()) {
+                cout << "Invalid event number: " << part << endl;
+                return;
+            }
+            chosen.push_back(events[stoi(part) - 1].getEventName());
+        }
+        if (chosen.empty()) {
+            cout << "No events selected!" << endl;
+            return;
+        }
+        
+        result = store.studentsOf(chosen[0]);
+        for (size_t i = 1; i < chosen.size(); i = i + 1) {
+            RoaringBitmap other = store.studentsOf(chosen[i]);
+            if (mode == 1) result.intersectWith(other);
+            else if (mode == 2) result.unionWith(other);
+            else result.subtract(other);
+        }
+    }
+    
+    vector<uint32_t> ids = result.values();
+    vector<string> names;
+    names.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); i = i + 1) {
+        names.push_back(store.studentName(ids[i]));
+    }
+    sort(names.begin(), names.end());
+    cout << '\n';
+    for (size_t i = 0; i < names.size(); i = i + 1) {
+        cout << "  " << names[i] << '\n';
+    }
+    cout << names.size() << " student(s)." << endl;
+}
+
+// A number of minutes as "45 min", "3h 20m" or "2d 5h"
+static string describeMinutes(double minutes) {
+    long long whole = static_cast<long long>(ceil(minutes));
+    if (whole < 60) return to_string(whole) + " min";
+    if (whole < 24 * 60) return to_string(whole / 60) + "h " + to_string(whole % 60) + "m";
+    return to_string(whole / (24 * 60)) + "d " + to_string(whole / 60 % 24) + "h";
+}
+
+// Which events are selling fastest, and when they will be full at the current pace
+// What it does: Reads the per-event sign-up counters of the last hour (one small ring per
+// event, kept by the store) instead of scanning every registration date
+void Admin::showRegistrationVelocity() {
+    OperationScope scope("Admin::showRegistrationVelocity");
+    cout << "\n=== REGISTRATION VELOCITY ===" << endl;
+    
+    vector<EventVelocity> rows = EventStore::instance().registrationVelocity(currentMinute());
+    if (rows.empty()) {
+        cout << "No registrations in the last hour." << endl;
+        return;
+    }
+    cout << left << setw(30) << "Event" << right << setw(8) << "15 min" << setw(8) << "60 min"
+         << setw(12) << "Seats left" << "   Full in" << '\n';
+    for (size_t i = 0; i < rows.size(); i = i + 1) {
+        const EventVelocity& row = rows[i];
+        cout << left << setw(30) << row.eventName << right << setw(8) << row.lastQuarterHour
+             << setw(8) << row.lastHour << setw(12) << row.seatsLeft << "   "
+             << (row.seatsLeft == 0 ? string("full") : describeMinutes(row.minutesToFull)) << '\n';
+    }
+    cout << left << rows.size() << " event(s) with registrations in the last hour "
+         << "(forecast at the last hour's pace)." << endl;
+}
+
+// One histogram line: label, count and a bar scaled against the largest count
+static void printHistogramRow(const string& label, long long count, long long largest) {
+    static const int BAR_WIDTH = 40;
+    int length = largest > 0 ? static_cast<int>(count * BAR_WIDTH / largest) : 0;
+    if (count > 0 && length == 0) length = 1;
+    cout << left << setw(30) << label << right << setw(10) << count << "  " << string(length, '#') << '\n';
+}
+
+// When students register, read straight from registrations.txt
+// What it does: One streaming pass over the file (registration_analytics.cpp) counts every
+// registration by hour of day, day, event and venue; the file is never loaded as a whole,
+// so this also works on registration histories far larger than memory
+void Admin::showRegistrationTimeAnalytics() {
+    OperationScope scope("Admin::showRegistrationTimeAnalytics");
+    cout << "\n=== REGISTRATION TIME ANALYTICS ===" << endl;
+    
+    static const size_t DAYS_SHOWN = 31;
+    static const size_t EVENTS_SHOWN = 10;
+    
+    RegistrationHistogram histogram;
+    if (!analyzeRegistrationTimes("data/registrations.txt", histogram)) {
+        cout << "Error: Could not open registrations.txt!" << endl;
+        return;
+    }
+    EventStore& store = EventStore::instance();
+    if (histogram.registrations == 0) {
+        cout << "No registrations in registrations.txt." << endl;
+        return;
+    }
+    
+    long long largest = *max_element(histogram.byHourOfDay, histogram.byHourOfDay + 24);
+    cout << "\nBy hour of day:" << '\n';
+    for (int hour = 0; hour < 24; hour = hour + 1) {
+        string label = (hour < 10 ? "0" : "") + to_string(hour) + ":00";
+        printHistogramRow(label, histogram.byHourOfDay[hour], largest);
+    }
+    
+    // Days in date order; only the most recent ones if the history is long
+    cout << "\nBy day:" << '\n';
+    largest = 0;
+    for (auto& day : histogram.byDay) {
+        largest = max(largest, day.second);
+    }
+    size_t skipped = histogram.byDay.size() > DAYS_SHOWN ? histogram.byDay.size() - DAYS_SHOWN : 0;
+    if (skipped > 0) cout << "(" << skipped << " earlier day(s) not shown)" << '\n';
+    auto day = histogram.byDay.begin();
+    advance(day, skipped);
+    for (; day != histogram.byDay.end(); ++day) {
+        printHistogramRow(dateOfDayNumber(day->first), day->second, largest);
+    }
+    
+    // Busiest events (a partial sort: only the first few need to be in order)
+    vector<pair<long long, string>> byEvent;
+    byEvent.reserve(histogram.byEvent.size());
+    for (auto& event : histogram.byEvent) {
+        byEvent.push_back(make_pair(-event.second, event.first));
+    }
+    size_t eventsShown = min(EVENTS_SHOWN, byEvent.size());
+    partial_sort(byEvent.begin(), byEvent.begin() + eventsShown, byEvent.end());
+    cout << "\nBusiest events:" << '\n';
+    for (size_t i = 0; i < eventsShown; i = i + 1) {
+        printHistogramRow(byEvent[i].second, -byEvent[i].first, -byEvent[0].first);
+    }
+    
+    vector<VenueRegistrations> venues = registrationsByVenue(histogram, store.getEvents());
+    cout << "\nBy venue:" << '\n';
+    for (size_t i = 0; i < venues.size(); i = i + 1) {
+        printHistogramRow(venues[i].venue, venues[i].registrations, venues[0].registrations);
+    }
+    
+    cout << left << "\n" << histogram.registrations << " registration(s) counted";
+    if (histogram.waitlistEntries > 0) cout << ", " << histogram.waitlistEntries << " waitlist entries skipped";
+    if (histogram.unreadableLines > 0) cout << ", " << histogram.unreadableLines << " line(s) without a readable date";
+    cout << "." << endl;
+    if (store.journalRecords() > 0) {
+        cout << "Note: " << store.journalRecords() << " recent change(s) are still only in the journal; "
+             << "checkpoint the data files (main menu 7) to include them." << endl;
+    }
+}
+
+// Checkpoint the data files on demand
+// What it does: Writes events.txt and registrations.txt from memory and trims the journal,
+// so the next start-up has nothing to replay (this also happens automatically)
+void Admin::checkpointDataFiles() {
+    OperationScope scope("Admin::checkpointDataFiles");
+    cout << "\n=== CHECKPOINT DATA FILES ===" << endl;
+    
+    EventStore& store = EventStore::instance();
+    store.getEvents();    // Make sure the journal has been read
+    cout << "Journal records not yet in the data files: " << store.journalRecords() << endl;
+    
+    if (store.checkpoint(true)) {
+        cout << "Checkpoint complete! events.txt and registrations.txt are up to date." << endl;
+    } else {
+        cout << "Error: Checkpoint failed - the journal was kept, no data was lost." << endl;
+    }
+}
+
+// Export the participant report of every event
+// What it does: Builds all reports in parallel (report_engine.cpp), then writes them out in bulk
+// Output: one file per event in reports/, or a single combined reports/all_events.txt
+void Admin::exportAllEventReports() {
+    OperationScope scope("Admin::exportAllEventReports");
+    cout << "\n=== EXPORT ALL EVENT REPORTS ===" << endl;
+    
+    if (EventStore::instance().getEvents().empty()) {
+        cout << "No events in the system!" << endl;
+        return;
+    }
+    
+    cout << "1. One file per event (reports/<event>.txt)" << endl;
+    cout << "2. Combined report (reports/all_events.txt)" << endl;
+    cout << "Choose option: ";
+    int choice;
+    cin >> choice;
+    cin.ignore();
+    
+    if (choice != 1 && choice != 2) {
+        cout << "Invalid choice!" << endl;
+        return;
+    }
+    
+    // The pool threads read a snapshot, never the live tables
+    shared_ptr<const StoreSnapshot> view = EventStore::instance().snapshot();
+    vector<EventReport> reports = buildAllEventReports(view->events, view->registrations);
+    
+    int participants = 0;
+    for (size_t i = 0; i < reports.size(); i = i + 1) {
+        participants = participants + reports[i].participantCount;
+    }
+    
+    if (choice == 1) {
+        int written = writeReportsPerEvent(reports, "reports");
+        cout << "Success! Wrote " << written << " of " << reports.size() << " report file(s) to reports/" << endl;
+    } else if (writeCombinedReport(reports, "reports/all_events.txt")) {
+        cout << "Success! Wrote " << reports.size() << " event report(s) to reports/all_events.txt" << endl;
+    } else {
+        cout << "Error: Could not write reports/all_events.txt!" << endl;
+        return;
+    }
+    cout << "Total Participants: " << participants << endl;
+}
+
 // Manage users (add new student)
 void Admin::manageUsers() {
     cout << "\n=== USER MANAGEMENT ===" << endl;
@@ -596,6 +1055,7 @@ void Admin::manageUsers() {
 
 // Add new student account
 void Admin::addNewStudent() {
+    OperationScope scope("Admin::addNewStudent");
     cout << "\n=== ADD NEW STUDENT ===" << endl;
     
     string username, password, fullName;
@@ -655,6 +1115,7 @@ void Admin::addNewStudent() {
 
 // View all users
 void Admin::viewAllUsers() {
+    OperationScope scope("Admin::viewAllUsers");
     cout << "\n=== ALL USERS ===" << endl;
     
     ifstream file("data/users.txt");
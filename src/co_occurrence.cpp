@@ -0,0 +1,115 @@
+#include "co_occurrence.h"
+#include <algorithm>
+#include <unordered_set>
+
+// ========================================
+// CO_OCCURRENCE.CPP - "Also Registered For" Counts
+// ========================================
+// This file keeps the sparse event-by-event co-registration counts behind the student
+// recommendations, and picks the best related events with a bounded heap.
+// Demonstrates: Sparse matrices as nested hash maps, incremental counting, top-N heaps
+
+void CoOccurrenceIndex::adjust(const string& a, const string& b, int delta) {
+    auto row = rows.find(a);
+    if (row == rows.end()) {
+        if (delta <= 0) return;
+        row = rows.emplace(a, unordered_map<string, int>()).first;
+    }
+    int& shared = row->second[b];
+    shared = shared + delta;
+    if (shared <= 0) {
+        row->second.erase(b);
+        if (row->second.empty()) rows.erase(row);
+    }
+}
+
+void CoOccurrenceIndex::addRegistration(const string& eventName, const vector<string>& otherEvents) {
+    for (size_t i = 0; i < otherEvents.size(); i = i + 1) {
+        if (otherEvents[i] == eventName) continue;
+        adjust(eventName, otherEvents[i], 1);
+        adjust(otherEvents[i], eventName, 1);
+    }
+}
+
+void CoOccurrenceIndex::removeRegistration(const string& eventName, const vector<string>& otherEvents) {
+    for (size_t i = 0; i < otherEvents.size(); i = i + 1) {
+        if (otherEvents[i] == eventName) continue;
+        adjust(eventName, otherEvents[i], -1);
+        adjust(otherEvents[i], eventName, -1);
+    }
+}
+
+void CoOccurrenceIndex::removeEvent(const string& eventName) {
+    auto row = rows.find(eventName);
+    if (row == rows.end()) return;
+    for (auto& shared : row->second) {
+        auto other = rows.find(shared.first);
+        if (other == rows.end()) continue;
+        other->second.erase(eventName);
+        if (other->second.empty()) rows.erase(other);
+    }
+    rows.erase(eventName);
+}
+
+// Take the row out, then add its counts back under the new name (both directions)
+void CoOccurrenceIndex::renameEvent(const string& oldName, const string& newName) {
+    if (oldName == newName) return;
+    auto row = rows.find(oldName);
+    if (row == rows.end()) return;
+    unordered_map<string, int> shared = row->second;
+    removeEvent(oldName);
+    for (auto& pair : shared) {
+        adjust(newName, pair.first, pair.second);
+        adjust(pair.first, newName, pair.second);
+    }
+}
+
+int CoOccurrenceIndex::count(const string& a, const string& b) const {
+    auto row = rows.find(a);
+    if (row == rows.end()) return 0;
+    auto shared = row->second.find(b);
+    return shared == row->second.end() ? 0 : shared->second;
+}
+
+// Score the neighbours of the seeds and keep the best n
+// What it does: Adds up each neighbour's counts over the seeds' rows, then runs the scores
+// through a heap of n entries whose top is the weakest one kept (ties: name order)
+vector<RelatedEvent> CoOccurrenceIndex::related(const vector<string>& seeds, size_t n,
+                                                const function<bool(const string&)>& keep) const {
+    unordered_set<string> seedSet(seeds.begin(), seeds.end());
+    unordered_map<string, int> scores;
+    for (const string& seed : seedSet) {
+        auto row = rows.find(seed);
+        if (row == rows.end()) continue;
+        for (auto& shared : row->second) {
+            if (seedSet.count(shared.first) == 0) scores[shared.first] += shared.second;
+        }
+    }
+
+    auto ranksBefore = [](const RelatedEvent& a, const RelatedEvent& b) {
+        if (a.score != b.score) return a.score > b.score;
+        return a.eventName < b.eventName;
+    };
+    vector<RelatedEvent> heap;
+    if (n == 0) return heap;
+    for (auto& candidate : scores) {
+        if (keep && !keep(candidate.first)) continue;
+        RelatedEvent related;
+        related.eventName = candidate.first;
+        related.score = candidate.second;
+        if (heap.size() < n) {
+            heap.push_back(related);
+            push_heap(heap.begin(), heap.end(), ranksBefore);
+        } else if (ranksBefore(related, heap.front())) {
+            pop_heap(heap.begin(), heap.end(), ranksBefore);
+            heap.back() = related;
+            push_heap(heap.begin(), heap.end(), ranksBefore);
+        }
+    }
+    sort_heap(heap.begin(), heap.end(), ranksBefore);
+    return heap;
+}
+
+void CoOccurrenceIndex::clear() {
+    rows.clear();
+}
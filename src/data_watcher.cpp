@@ -0,0 +1,100 @@
+#include "data_watcher.h"
+#include <algorithm>
+#include <cerrno>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ========================================
+// DATA_WATCHER.CPP - Change Notification for data/
+// ========================================
+// This file tells the store when the data files or the journal changed on disk, so a
+// session that stays open all day can pick up other sessions' changes without
+// re-reading anything when nothing happened.
+// Demonstrates: inotify, non-blocking reads, stat() as a portable fallback
+
+// Everything that can change a file's contents or replace it (checkpoints use rename)
+static const uint32_t WATCH_MASK = IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE |
+                                   IN_MOVED_TO | IN_MOVED_FROM;
+
+DataWatcher::DataWatcher(const string& dir, const vector<string>& fileNames)
+    : directory(dir), names(fileNames), started(false), inotifyFd(-1) {}
+
+DataWatcher::~DataWatcher() {
+    if (inotifyFd >= 0) close(inotifyFd);
+}
+
+// Watch the directory rather than the files: a checkpoint renames new files over the old
+// ones, and a watch on a file would stay attached to the replaced copy
+void DataWatcher::start() {
+    if (started) return;
+    started = true;
+
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd >= 0 && inotify_add_watch(inotifyFd, directory.c_str(), WATCH_MASK) < 0) {
+        close(inotifyFd);
+        inotifyFd = -1;
+    }
+    if (inotifyFd < 0) {
+        signatures.clear();
+        for (size_t i = 0; i < names.size(); i = i + 1) {
+            signatures.push_back(signatureOf(names[i]));
+        }
+    }
+}
+
+DataWatcher::Signature DataWatcher::signatureOf(const string& name) const {
+    Signature signature;
+    struct stat info;
+    if (stat((directory + "/" + name).c_str(), &info) == 0) {
+        signature.exists = true;
+        signature.inode = info.st_ino;
+        signature.size = info.st_size;
+        signature.modified = info.st_mtim;
+    }
+    return signature;
+}
+
+// Collect the files changed since the last call
+// What it does: Drains every queued inotify event and keeps the ones naming a watched file.
+// A queue overflow means events were lost, so every file is reported.
+vector<string> DataWatcher::changedFiles() {
+    vector<string> changed;
+    if (!started) return changed;
+
+    auto add = [&changed](const string& name) {
+        if (find(changed.begin(), changed.end(), name) == changed.end()) changed.push_back(name);
+    };
+
+    if (inotifyFd < 0) {
+        for (size_t i = 0; i < names.size(); i = i + 1) {
+            Signature now = signatureOf(names[i]);
+            const Signature& before = signatures[i];
+            if (now.exists != before.exists || now.inode != before.inode || now.size != before.size ||
+                now.modified.tv_sec != before.modified.tv_sec || now.modified.tv_nsec != before.modified.tv_nsec) {
+                add(names[i]);
+            }
+            signatures[i] = now;
+        }
+        return changed;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        ssize_t got = read(inotifyFd, buffer, sizeof(buffer));
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;    // EAGAIN: the queue is empty
+
+        for (char* p = buffer; p < buffer + got; p = p + sizeof(inotify_event) + reinterpret_cast<inotify_event*>(p)->len) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+            if (event->mask & IN_Q_OVERFLOW) {
+                for (size_t i = 0; i < names.size(); i = i + 1) add(names[i]);
+                continue;
+            }
+            if (event->len == 0) continue;
+            string name(event->name);
+            if (find(names.begin(), names.end(), name) != names.end()) add(name);
+        }
+    }
+    return changed;
+}
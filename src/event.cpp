@@ -1,5 +1,7 @@
 #include "event.h"
+#include "table_renderer.h"    // Buffered table rows
 #include <iomanip>    // For formatting output (setw, setprecision, etc.)
+#include <algorithm>  // For max
 
 // ========================================
 // EVENT.CPP - Event Class Implementation
@@ -16,7 +18,8 @@ Event::Event(string name, string d, string v, int cap, int reg)
       date(d),                   // Initialize date
       venue(v),                  // Initialize venue
       capacity(cap),             // Initialize maximum capacity
-      registeredCount(reg) {}    // Initialize current registration count
+      registeredCount(reg),      // Initialize current registration count
+      heldSeats(0) {}            // No seats on hold yet
 
 // Getter methods - Provide read-only access to private member variables
 // 'const' at the end means these functions don't modify the object (they're read-only)
@@ -41,7 +44,19 @@ int Event::getRegisteredCount() const {
 }
 
 int Event::getAvailableSeats() const { 
-    return capacity - registeredCount;  // Calculate remaining seats
+    return max(0, capacity - registeredCount - heldSeats);  // Calculate remaining seats
+}
+
+int Event::getHeldSeats() const {
+    return heldSeats;            // Return how many seats are on hold
+}
+
+string Event::getStartTime() const {
+    return startTime;            // Return when the event starts (HH:MM, empty if all day)
+}
+
+string Event::getEndTime() const {
+    return endTime;              // Return when the event ends (HH:MM, empty if all day)
 }
 
 // Setter methods - Allow controlled modification of private member variables
@@ -66,18 +81,29 @@ void Event::setRegisteredCount(int count) {
     registeredCount = count;     // Update registration count
 }
 
+void Event::setHeldSeats(int count) {
+    heldSeats = count;           // Update the number of held seats
+}
+
+void Event::setTimes(const string& start, const string& end) {
+    startTime = start;           // Update start and end together (both empty = all day)
+    endTime = end;
+}
+
 // Check if event has available seats
 // What it does: Returns true if there's room for more students, false if full
 // Used before: Allowing a student to register
+// Seats on hold count as taken, so a held seat is never offered to somebody else
 bool Event::hasAvailableSeats() const {
-    return registeredCount < capacity;   // True if registrations haven't reached capacity
+    return registeredCount + heldSeats < capacity;   // True if registrations and holds haven't reached capacity
 }
 
 // Increment registered count when a student registers
 // What it does: Increases the registration count by 1 (if space available)
-// Safety check: Only increments if seats are available
+// Safety check: Only increments while below capacity (holds are not checked here: the
+// student confirming a hold takes the held seat, see EventStore)
 void Event::registerStudent() {
-    if (hasAvailableSeats()) {           // Check if there's space
+    if (registeredCount < capacity) {    // Check if there's space
         registeredCount = registeredCount + 1;               // Increase count by 1
     }
 }
@@ -93,32 +119,37 @@ void Event::unregisterStudent() {
 
 // Format event data for file storage (pipe-delimited)
 // What it does: Converts the Event object into a string for saving to events.txt
-// Format: eventname|date|venue|capacity|registeredcount
-// Example: "Tech Fest 2025|15-03-2025|Main Auditorium|100|45"
+// Format: eventname|date|venue|capacity|registeredcount, plus |start|end when the event has times
+// Example: "Tech Fest 2025|15-03-2025|Main Auditorium|100|45|09:00|17:00"
 // Why pipe (|): We use | as separator because event names/venues might contain commas
 string Event::toFileFormat() const {
-    return eventName + "|" + date + "|" + venue + "|" + 
-           to_string(capacity) + "|" + to_string(registeredCount);
+    string line = eventName + "|" + date + "|" + venue + "|" + 
+                  to_string(capacity) + "|" + to_string(registeredCount);
+    if (!startTime.empty()) line += "|" + startTime + "|" + endTime;
+    return line;
 }
 
 // Display event information in table format
-// What it does: Prints event in a formatted table row
+// What it does: Prints event as one formatted table row
 // Parameters: index (optional row number for display)
-// Used in: Listing all events in a table view
+// Whole lists should use renderEventTable() instead, which buffers every row of a page
 void Event::display(int index) const {
-    cout << "  ";
-    
-    // If index is provided (> 0), show the row number
-    if (index > 0) cout << setw(2) << index << ". ";
-    
-    // setw(n) sets the width for the next output (for alignment)
-    // left makes text align to the left within that width
-    cout << left << setw(25) << eventName << " | "      // Event name (25 chars wide)
-         << setw(12) << date << " | "                   // Date (12 chars wide)
-         << setw(20) << venue << " | "                  // Venue (20 chars wide)
-         << setw(4) << capacity << " | "                // Capacity (4 chars wide)
-         << setw(4) << registeredCount << " | "         // Registered (4 chars wide)
-         << getAvailableSeats() << endl;                // Available seats
+    TableRenderer table(cout, eventTableColumns(), 110);
+    appendTableRow(table, index);
+}
+
+// Add this event as a table row
+// What it does: Hands each field to the renderer, which pads it to the column width
+// Column widths (name 25, date 12, venue 20, cap 4, reg 4) live in eventTableColumns()
+void Event::appendTableRow(TableRenderer& table, int index) const {
+    table.beginRow(index);
+    table.cell(eventName);
+    table.cell(date);
+    table.cell(venue);
+    table.cell(capacity);
+    table.cell(registeredCount);
+    table.cell(getAvailableSeats());    // Available seats
+    table.endRow();
 }
 
 // Display detailed event information
@@ -131,9 +162,11 @@ void Event::displayDetailed(int index) const {
     
     cout << "Name: " << eventName << endl;
     cout << "Date: " << date << endl;
+    cout << "Time: " << (startTime.empty() ? "All day" : startTime + " - " + endTime) << endl;
     cout << "Venue: " << venue << endl;
     cout << "Total Capacity: " << capacity << endl;
     cout << "Registered Students: " << registeredCount << endl;
+    if (heldSeats > 0) cout << "Seats On Hold: " << heldSeats << endl;
     cout << "Available Seats: " << getAvailableSeats() << endl;
     
     // Calculate and display occupancy percentage
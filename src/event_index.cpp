@@ -0,0 +1,132 @@
+#include "event_index.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ========================================
+// EVENT_INDEX.CPP - Offset Index for events.txt
+// ========================================
+// This file writes and searches data/events.txt.idx, a small sorted list of
+// "eventname|byte offset" lines. Looking up one event costs a binary search over the
+// index plus one seek into events.txt, instead of reading and parsing every event.
+// Demonstrates: Binary search on a file (pread), sidecar index files
+
+static const string INDEX_HEADER = "#checkpoint|";
+static const size_t SEQUENCE_WIDTH = 20;
+static const size_t READ_BLOCK = 256;
+
+string eventIndexHeader(long long sequence) {
+    string digits = to_string(sequence);
+    return INDEX_HEADER + string(SEQUENCE_WIDTH - min(digits.size(), SEQUENCE_WIDTH), '0') + digits;
+}
+
+// Build the index file contents (entries are sorted by name, byte by byte)
+string formatEventIndex(vector<EventOffset> entries, long long sequence) {
+    stable_sort(entries.begin(), entries.end(), [](const EventOffset& a, const EventOffset& b) {
+        return a.name < b.name;
+    });
+    string text = eventIndexHeader(sequence) + '\n';
+    for (size_t i = 0; i < entries.size(); i = i + 1) {
+        text += entries[i].name + "|" + to_string(entries[i].offset) + '\n';
+    }
+    return text;
+}
+
+// Read a whole field as a number (false if it isn't one)
+static bool readNumber(const string& text, long long& value) {
+    auto result = from_chars(text.data(), text.data() + text.size(), value);
+    return !text.empty() && result.ec == errc() && result.ptr == text.data() + text.size();
+}
+
+// Read the line starting at 'offset'
+// 'next' is set to the offset just after its newline (false at end of file or on error)
+static bool readLineFrom(int fd, long long offset, string& line, long long& next) {
+    line.clear();
+    char buffer[READ_BLOCK];
+    while (true) {
+        ssize_t got = pread(fd, buffer, sizeof(buffer), offset + static_cast<long long>(line.size()));
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (got == 0) {
+            next = offset + static_cast<long long>(line.size());
+            return !line.empty();
+        }
+        const char* newline = static_cast<const char*>(memchr(buffer, '\n', static_cast<size_t>(got)));
+        if (newline != nullptr) {
+            line.append(buffer, newline - buffer);
+            next = offset + static_cast<long long>(line.size()) + 1;
+            return true;
+        }
+        line.append(buffer, static_cast<size_t>(got));
+    }
+}
+
+// Split "name|offset" (the name is everything before the last bar)
+static bool parseIndexLine(const string& line, string& name, long long& offset) {
+    size_t bar = line.rfind('|');
+    if (bar == string::npos) return false;
+    name = line.substr(0, bar);
+    return readNumber(line.substr(bar + 1), offset);
+}
+
+// Binary search over the lines of the index
+// What it does: Keeps [low, high) as a byte range that starts on a line; each step jumps to
+// the first line starting at or after the middle and compares its name. When no line starts
+// in the upper half, the few lines left are checked one by one.
+bool lookupEventOffset(const string& indexPath, const string& name, long long& indexSequence, long long& offset) {
+    int fd = open(indexPath.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    string line;
+    long long low = 0;
+    bool ok = fstat(fd, &info) == 0 && readLineFrom(fd, 0, line, low) &&
+              line.compare(0, INDEX_HEADER.size(), INDEX_HEADER) == 0 &&
+              readNumber(line.substr(INDEX_HEADER.size()), indexSequence);
+    long long high = ok ? static_cast<long long>(info.st_size) : 0;
+    offset = -1;
+
+    string key;
+    long long keyOffset = 0;
+    long long next = 0;
+    while (ok && low < high) {
+        long long middle = low + (high - low) / 2;
+        long long start = low;
+        if (middle > low && !readLineFrom(fd, middle - 1, line, start)) ok = false;
+
+        if (ok && start >= high) {
+            // No line starts in the upper half: check the few left in order
+            for (long long at = low; ok && at < high; at = next) {
+                ok = readLineFrom(fd, at, line, next) && parseIndexLine(line, key, keyOffset);
+                if (ok && key == name) offset = keyOffset;
+            }
+            break;
+        }
+
+        ok = ok && readLineFrom(fd, start, line, next) && parseIndexLine(line, key, keyOffset);
+        if (!ok) break;
+        if (key == name) {
+            offset = keyOffset;
+            break;
+        }
+        if (key < name) low = next;
+        else high = start;
+    }
+
+    close(fd);
+    return ok;
+}
+
+bool readLineAt(const string& path, long long offset, string& line) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    long long next = 0;
+    bool ok = readLineFrom(fd, offset, line, next);
+    close(fd);
+    return ok;
+}
@@ -0,0 +1,122 @@
+#include "event_ranking.h"
+#include "metrics.h"
+#include "utils.h"
+#include <algorithm>
+#include <cstdio>
+
+// ========================================
+// EVENT_RANKING.CPP - Top-K and Threshold Queries
+// ========================================
+// This file answers "most popular", "nearly full" and "emptiest upcoming" questions.
+// Top-K keeps a heap of only the k best events seen so far: each event costs at most
+// O(log k), so ranking n events is O(n log k) rather than a full O(n log n) sort.
+// Demonstrates: Bounded heaps (push_heap/pop_heap), std::function keys, date arithmetic
+
+double occupancyPercent(const Event& event) {
+    if (event.getCapacity() <= 0) return 0;
+    return event.getRegisteredCount() * 100.0 / event.getCapacity();
+}
+
+// Select the k best events by 'score'
+// What it does: The heap's top is always the *worst* of the current k candidates,
+// so a new event only gets in if it beats that one (and then replaces it)
+vector<const Event*> selectTopEvents(const vector<Event>& events, size_t k,
+                                     const function<double(const Event&)>& score,
+                                     bool highestFirst,
+                                     const function<bool(const Event&)>& keep) {
+    OperationScope scope("selectTopEvents");
+    vector<const Event*> result;
+    if (k == 0) return result;
+
+    // "a ranks before b": higher score (or lower, for bottom-K); ties keep file order
+    typedef pair<double, size_t> Candidate;    // score, position in 'events'
+    auto ranksBefore = [highestFirst](const Candidate& a, const Candidate& b) {
+        if (a.first != b.first) return highestFirst ? a.first > b.first : a.first < b.first;
+        return a.second < b.second;
+    };
+
+    // With ranksBefore as the comparator, the heap top is the candidate that ranks last
+    vector<Candidate> heap;
+    heap.reserve(min(k, events.size()) + 1);
+    for (size_t i = 0; i < events.size(); i = i + 1) {
+        if (keep && !keep(events[i])) continue;
+        Candidate candidate(score(events[i]), i);
+        if (heap.size() < k) {
+            heap.push_back(candidate);
+            push_heap(heap.begin(), heap.end(), ranksBefore);
+        } else if (ranksBefore(candidate, heap.front())) {
+            pop_heap(heap.begin(), heap.end(), ranksBefore);
+            heap.back() = candidate;
+            push_heap(heap.begin(), heap.end(), ranksBefore);
+        }
+    }
+
+    // Only the k survivors are sorted
+    sort_heap(heap.begin(), heap.end(), ranksBefore);
+    result.reserve(heap.size());
+    for (size_t i = 0; i < heap.size(); i = i + 1) {
+        result.push_back(&events[heap[i].second]);
+    }
+    return result;
+}
+
+vector<const Event*> mostPopularEvents(const vector<Event>& events, size_t k) {
+    return selectTopEvents(events, k, [](const Event& e) {
+        return static_cast<double>(e.getRegisteredCount());
+    });
+}
+
+// Threshold query: the matching events are usually few, so only they get sorted
+vector<const Event*> nearlyFullEvents(const vector<Event>& events, double percent) {
+    return selectTopEvents(events, events.size(), occupancyPercent, true, [percent](const Event& e) {
+        return e.getCapacity() > 0 && occupancyPercent(e) >= percent;
+    });
+}
+
+vector<const Event*> emptiestEventsInWindow(const vector<Event>& events, size_t k,
+                                            const string& fromDate, int days) {
+    // Half-open window [first, end): 'fromDate' counts as the first of the 'days' days,
+    // so a 7-day window is today plus the next six days, not eight calendar days
+    long long first = dayNumber(fromDate);
+    long long end = first + days;
+    return selectTopEvents(events, k, occupancyPercent, false, [first, end](const Event& e) {
+        long long day = dayNumber(e.getDate());
+        return first >= 0 && day >= first && day < end;
+    });
+}
+
+// Convert DD-MM-YYYY to a day count (the usual civil-calendar formula, March-based year)
+long long dayNumber(const string& date) {
+    // Only the shape is checked here (isValidDate also rejects past years, which we need to read)
+    if (date.size() != 10 || date[2] != '-' || date[5] != '-' ||
+        !isNumeric(date.substr(0, 2)) || !isNumeric(date.substr(3, 2)) || !isNumeric(date.substr(6, 4))) {
+        return -1;
+    }
+    return civilDayNumber(stoi(date.substr(6, 4)), stoi(date.substr(3, 2)), stoi(date.substr(0, 2)));
+}
+
+long long civilDayNumber(long long year, long long month, long long day) {
+    year = year - (month <= 2 ? 1 : 0);
+    long long era = year / 400;
+    long long yearOfEra = year - era * 400;
+    long long dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// The inverse of civilDayNumber(), as DD-MM-YYYY
+string dateOfDayNumber(long long days) {
+    days = days + 719468;
+    long long era = (days >= 0 ? days : days - 146096) / 146097;
+    long long dayOfEra = days - era * 146097;
+    long long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    long long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    long long shiftedMonth = (5 * dayOfYear + 2) / 153;
+    long long day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    long long month = shiftedMonth + (shiftedMonth < 10 ? 3 : -9);
+    long long year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+
+    char text[64];
+    snprintf(text, sizeof(text), "%02lld-%02lld-%04lld", day, month, year);
+    return string(text);
+}
@@ -0,0 +1,90 @@
+#include "event_schedule.h"
+#include "event_ranking.h"
+#include "utils.h"
+#include <algorithm>
+#include <unordered_map>
+
+// ========================================
+// EVENT_SCHEDULE.CPP - Event Times and Venue Conflicts
+// ========================================
+// This file turns an event's date and times into one number line (minutes) and finds
+// every pair of events booked into the same venue at the same time.
+// (EventStore uses the same minutes for its venue and student timetable interval trees.)
+// Demonstrates: Sweep-line algorithms, heaps (push_heap/pop_heap), grouping with hash maps
+
+static const long long MINUTES_PER_DAY = 24 * 60;
+
+// "HH:MM" → minutes after midnight (callers check the format first)
+static long long minuteOfDay(const string& time) {
+    return stoi(time.substr(0, 2)) * 60LL + stoi(time.substr(3, 2));
+}
+
+bool eventInterval(const Event& event, long long& start, long long& end) {
+    long long day = dayNumber(event.getDate());
+    if (day < 0) return false;
+    start = day * MINUTES_PER_DAY;
+    end = start + MINUTES_PER_DAY;
+    if (isValidTime(event.getStartTime()) && isValidTime(event.getEndTime())) {
+        end = start + minuteOfDay(event.getEndTime());
+        start = start + minuteOfDay(event.getStartTime());
+    }
+    return end > start;
+}
+
+string describeTimeSlot(const Event& event) {
+    if (event.getStartTime().empty()) return event.getDate() + " all day";
+    return event.getDate() + " " + event.getStartTime() + "-" + event.getEndTime();
+}
+
+string venueKey(const string& venue) {
+    return toLower(trim(venue));
+}
+
+// Find all double bookings
+// What it does: Groups the events by venue, then walks each venue's events in start order.
+// Events that ended by the time the next one starts are popped off the heap (earliest end
+// first); whatever is left is still running, so each of those overlaps the new event.
+vector<VenueConflict> auditVenueConflicts(const vector<Event>& events) {
+    struct Slot {
+        long long start;
+        long long end;
+        size_t index;
+    };
+    unordered_map<string, vector<Slot>> byVenue;
+    vector<string> venueOrder;    // First appearance order, so the report is stable
+    for (size_t i = 0; i < events.size(); i = i + 1) {
+        Slot slot;
+        if (!eventInterval(events[i], slot.start, slot.end)) continue;
+        slot.index = i;
+        string key = venueKey(events[i].getVenue());
+        if (byVenue.find(key) == byVenue.end()) venueOrder.push_back(key);
+        byVenue[key].push_back(slot);
+    }
+
+    vector<VenueConflict> conflicts;
+    for (size_t v = 0; v < venueOrder.size(); v = v + 1) {
+        vector<Slot>& slots = byVenue[venueOrder[v]];
+        if (slots.size() < 2) continue;
+        sort(slots.begin(), slots.end(), [](const Slot& a, const Slot& b) {
+            return a.start != b.start ? a.start < b.start : a.index < b.index;
+        });
+
+        // Heap in a plain vector (push_heap/pop_heap), so the running events can also be listed
+        auto endsLater = [&slots](size_t a, size_t b) { return slots[a].end > slots[b].end; };
+        vector<size_t> running;
+        for (size_t i = 0; i < slots.size(); i = i + 1) {
+            while (!running.empty() && slots[running.front()].end <= slots[i].start) {
+                pop_heap(running.begin(), running.end(), endsLater);
+                running.pop_back();
+            }
+            for (size_t k = 0; k < running.size(); k = k + 1) {
+                const Slot& earlier = slots[running[k]];
+                conflicts.push_back(VenueConflict{ events[earlier.index].getVenue(),
+                                                   events[earlier.index], events[slots[i].index] });
+            }
+            running.push_back(i);
+            push_heap(running.begin(), running.end(), endsLater);
+        }
+    }
+    return conflicts;
+}
@@ -0,0 +1,99 @@
+#include "event_stats.h"
+
+// ========================================
+// EVENT_STATS.CPP - Running Event Statistics
+// ========================================
+// This file keeps totals (capacity, registrations, per-venue, per-date, occupancy histogram)
+// up to date as events change, so the statistics screen never has to re-add everything.
+// Demonstrates: Incremental aggregation, unordered_map (hash tables)
+
+// Constructor - starts with empty aggregates
+EventStats::EventStats() {
+    clear();
+}
+
+// Reset all totals to zero
+void EventStats::clear() {
+    totalEvents = 0;
+    totalCapacity = 0;
+    totalRegistered = 0;
+    byVenue.clear();
+    byDate.clear();
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i = i + 1) {
+        histogram[i] = 0;
+    }
+}
+
+// Count a new (or updated) event into the aggregates
+void EventStats::addEvent(const Event& event) {
+    apply(event, +1);
+}
+
+// Take an event (or its old version before an update) out of the aggregates
+void EventStats::removeEvent(const Event& event) {
+    apply(event, -1);
+}
+
+// Shared add/remove logic
+// What it does: Adjusts every aggregate by +event or -event
+// Rollups that drop to zero events are erased so the maps only hold live venues/dates
+void EventStats::apply(const Event& event, int sign) {
+    totalEvents = totalEvents + sign;
+    totalCapacity = totalCapacity + sign * static_cast<long long>(event.getCapacity());
+    totalRegistered = totalRegistered + sign * static_cast<long long>(event.getRegisteredCount());
+    histogram[occupancyBucket(event)] = histogram[occupancyBucket(event)] + sign;
+
+    // Same update for the venue rollup and the date rollup
+    unordered_map<string, StatsRollup>* maps[2] = { &byVenue, &byDate };
+    const string keys[2] = { event.getVenue(), event.getDate() };
+    for (int i = 0; i < 2; i = i + 1) {
+        StatsRollup& rollup = (*maps[i])[keys[i]];
+        rollup.eventCount = rollup.eventCount + sign;
+        rollup.capacity = rollup.capacity + sign * static_cast<long long>(event.getCapacity());
+        rollup.registered = rollup.registered + sign * static_cast<long long>(event.getRegisteredCount());
+        if (rollup.eventCount <= 0) {
+            maps[i]->erase(keys[i]);
+        }
+    }
+}
+
+// Getters
+int EventStats::getTotalEvents() const {
+    return totalEvents;
+}
+
+long long EventStats::getTotalCapacity() const {
+    return totalCapacity;
+}
+
+long long EventStats::getTotalRegistered() const {
+    return totalRegistered;
+}
+
+// Overall occupancy as a percentage (0 when there is no capacity at all)
+double EventStats::getOverallOccupancy() const {
+    return totalCapacity > 0 ? (totalRegistered * 100.0 / totalCapacity) : 0;
+}
+
+const unordered_map<string, StatsRollup>& EventStats::getVenueRollups() const {
+    return byVenue;
+}
+
+const unordered_map<string, StatsRollup>& EventStats::getDateRollups() const {
+    return byDate;
+}
+
+int EventStats::getHistogramCount(int bucket) const {
+    if (bucket < 0 || bucket >= HISTOGRAM_BUCKETS) return 0;
+    return histogram[bucket];
+}
+
+// Which histogram bucket an event falls into
+// Example: 45/50 registered = 90% → bucket 9; 50/50 → bucket 10 (full)
+int EventStats::occupancyBucket(const Event& event) {
+    if (event.getCapacity() <= 0) return 0;
+    int bucket = event.getRegisteredCount() * 10 / event.getCapacity();
+    if (bucket < 0) bucket = 0;
+    if (bucket >= HISTOGRAM_BUCKETS) bucket = HISTOGRAM_BUCKETS - 1;
+    return bucket;
+}
@@ -0,0 +1,1999 @@
+#include "event_store.h"
+#include "thread_pool.h"
+#include "durable_file.h"
+#include "event_index.h"
+#include "metrics.h"
+#include <fstream>
+#include <charconv>
+#include <memory>
+#include <unordered_map>
+#include <sys/stat.h>
+
+// ========================================
+// EVENT_STORE.CPP - Shared Event/Registration Store
+// ========================================
+// This file owns the in-memory events and registrations tables.
+// Admin and Student both go through it, so the files are parsed once per session
+// and the statistics are kept up to date as each change happens.
+// Changes are appended to data/journal.txt; a checkpoint rewrites the data files
+// in the background and trims the journal.
+// Demonstrates: Singleton object, File I/O, write-ahead journal, checkpoints, tombstones
+
+static const char* EVENTS_FILE = "data/events.txt";
+static const char* REGISTRATIONS_FILE = "data/registrations.txt";
+static const char* EVENTS_INDEX_FILE = "data/events.txt.idx";    // Sidecar: event name → byte offset
+static const char* VENUES_FILE = "data/venues.txt";    // Venue|rows|seats per row (numbered seating)
+static const char* COMMIT_MARKER = "data/commit.pending";    // Exists only while a checkpoint commits
+static const char* CHECKPOINT_LOCK = "data/checkpoint.lock";  // Held by whoever commits or recovers
+
+// First line of a checkpointed data file: "#checkpoint|<last journal sequence in this file>"
+static const string CHECKPOINT_HEADER = "#checkpoint|";
+
+// A checkpoint starts by itself once the journal holds this many records, or half as many
+// records as the two tables together, whichever is larger
+static const size_t CHECKPOINT_MIN_RECORDS = 500;
+
+// Read a whole field as a number (false if it isn't one)
+static bool readNumber(const string& text, long long& value) {
+    auto result = from_chars(text.data(), text.data() + text.size(), value);
+    return !text.empty() && result.ec == errc() && result.ptr == text.data() + text.size();
+}
+
+// Optional fixed-width events.txt layout (--fixed-width-events)
+// Every field is padded to a known width, so row i starts at a known byte offset and
+// a changed seat count can be overwritten in place instead of rewriting the file.
+//   #checkpoint|00000000000000000042|fixed-width
+//   Tech Fest 2025                          |15-03-2025|Main Auditorium               |     200|      45|09:00|17:00
+// (the two times are blank for an all-day event)
+static const string FIXED_WIDTH_TAG = "fixed-width";
+static const size_t SEQUENCE_WIDTH = 20;
+static const size_t NAME_WIDTH = 40;
+static const size_t DATE_WIDTH = 10;
+static const size_t VENUE_WIDTH = 30;
+static const size_t NUMBER_WIDTH = 8;
+static const size_t TIME_WIDTH = 5;
+static const size_t FIXED_HEADER_LENGTH = CHECKPOINT_HEADER.size() + SEQUENCE_WIDTH + 1 + FIXED_WIDTH_TAG.size() + 1;
+static const size_t FIXED_ROW_LENGTH = NAME_WIDTH + DATE_WIDTH + VENUE_WIDTH + 2 * NUMBER_WIDTH + 2 * TIME_WIDTH + 7;    // 6 bars + '\n'
+static const size_t REGISTERED_OFFSET = NAME_WIDTH + DATE_WIDTH + VENUE_WIDTH + NUMBER_WIDTH + 4;
+
+// Sequence number from a checkpoint header (0 for any other line, e.g. files from older versions)
+// 'fixedWidth' is set if the header announces the fixed-width layout
+static long long headerSequence(const string& line, bool* fixedWidth = nullptr) {
+    long long sequence = 0;
+    if (line.compare(0, CHECKPOINT_HEADER.size(), CHECKPOINT_HEADER) != 0) return 0;
+    string rest = line.substr(CHECKPOINT_HEADER.size());
+    size_t bar = rest.find('|');
+    if (fixedWidth != nullptr) {
+        *fixedWidth = bar != string::npos && trim(rest.substr(bar + 1)) == FIXED_WIDTH_TAG;
+    }
+    string number = trim(rest.substr(0, bar));
+    return readNumber(number, sequence) ? sequence : 0;
+}
+
+static string padRight(const string& text, size_t width) {
+    return text.size() >= width ? text : text + string(width - text.size(), ' ');
+}
+
+static string padNumber(long long value, size_t width) {
+    string digits = to_string(value);
+    return digits.size() >= width ? digits : string(width - digits.size(), ' ') + digits;
+}
+
+// Can this event be stored in a fixed-width row?
+static bool fitsFixedWidth(const Event& event) {
+    return event.getEventName().size() <= NAME_WIDTH && event.getDate().size() <= DATE_WIDTH &&
+           event.getVenue().size() <= VENUE_WIDTH &&
+           to_string(event.getCapacity()).size() <= NUMBER_WIDTH &&
+           to_string(event.getRegisteredCount()).size() <= NUMBER_WIDTH;
+}
+
+// Header and rows of the fixed-width layout, without the trailing newline
+static string fixedHeader(long long sequence) {
+    string digits = to_string(sequence);
+    return CHECKPOINT_HEADER + string(SEQUENCE_WIDTH - digits.size(), '0') + digits + "|" + FIXED_WIDTH_TAG;
+}
+
+static string fixedRow(const Event& event) {
+    return padRight(event.getEventName(), NAME_WIDTH) + "|" + padRight(event.getDate(), DATE_WIDTH) + "|" +
+           padRight(event.getVenue(), VENUE_WIDTH) + "|" + padNumber(event.getCapacity(), NUMBER_WIDTH) + "|" +
+           padNumber(event.getRegisteredCount(), NUMBER_WIDTH) + "|" + padRight(event.getStartTime(), TIME_WIDTH) + "|" +
+           padRight(event.getEndTime(), TIME_WIDTH);
+}
+
+// events.txt contents: header, then one event per line (fixed-width rows if asked for)
+// The byte offset of every line is collected for the index file
+static string formatEventsFile(const vector<Event>& events, long long sequence, bool fixedWidth,
+                               vector<EventOffset>& offsets) {
+    string text = fixedWidth ? fixedHeader(sequence) + '\n' : CHECKPOINT_HEADER + to_string(sequence) + '\n';
+    offsets.clear();
+    for (size_t i = 0; i < events.size(); i = i + 1) {
+        offsets.push_back(EventOffset{ events[i].getEventName(), static_cast<long long>(text.size()) });
+        text += fixedWidth ? fixedRow(events[i]) : events[i].toFileFormat();
+        text += '\n';
+    }
+    return text;
+}
+
+// registrations.txt contents: header, registrations, waitlist entries in join order, then seat holds
+static string formatRegistrationsFile(const vector<Registration>& registrations, const vector<WaitlistEntry>& waiting,
+                                      const vector<HoldEntry>& held, long long sequence) {
+    string text = CHECKPOINT_HEADER + to_string(sequence) + '\n';
+    for (size_t i = 0; i < registrations.size(); i = i + 1) {
+        text += registrations[i].toFileFormat();
+        text += '\n';
+    }
+    for (size_t i = 0; i < waiting.size(); i = i + 1) {
+        text += waiting[i].toFileFormat();
+        text += '\n';
+    }
+    for (size_t i = 0; i < held.size(); i = i + 1) {
+        text += held[i].toFileFormat();
+        text += '\n';
+    }
+    return text;
+}
+
+// Get the single shared store
+// What it does: Creates the store the first time it's needed (function-local static)
+EventStore& EventStore::instance() {
+    static EventStore store;
+    return store;
+}
+
+// Constructor - nothing is loaded until somebody asks for data
+EventStore::EventStore()
+    : journal("data/journal.txt"), orphansInMemory(false), eventsLoaded(false), registrationsLoaded(false),
+      eventsFileSequence(0), registrationsFileSequence(0), journalErrorsReported(false),
+      watcher("data", { "events.txt", "registrations.txt", "journal.txt" }), lastCheckpointSequence(-1),
+      fixedWidthEvents(false), eventsFilePatchable(false), changeVersion(0), registrationsRebuilt(true),
+      nextHoldId(1), holdTimers(time(0)), venuesLoaded(false),
+      venueSchedulesBuilt(false), eventStudentsBuilt(false),
+      coRegistrationsBuilt(false), registrationRatesBuilt(false) {
+    // A checkpoint that crashed part-way is finished (or cleaned up) before anything is read.
+    // Done once per process, under the lock every checkpoint commits under, so it never touches
+    // the files of another session's checkpoint that is still running.
+    ExclusiveFileLock lock(CHECKPOINT_LOCK);
+    if (lock.held()) recoverInterruptedCommit({ EVENTS_FILE, EVENTS_INDEX_FILE, REGISTRATIONS_FILE }, COMMIT_MARKER);
+}
+
+// Parse one events.txt line: eventname|date|venue|capacity|registered|start|end
+// The registered count (5th field) and the times (6th and 7th) are optional
+static bool parseEventLine(const string& line, Event& event) {
+    vector<string> parts = split(line, '|');
+    if (parts.size() < 4) return false;
+    int capacity = static_cast<int>(stoi(trim(parts[3])));
+    int registered = (parts.size() > 4) ? static_cast<int>(stoi(trim(parts[4]))) : 0;
+    event = Event(trim(parts[0]), trim(parts[1]), trim(parts[2]), capacity, registered);
+    if (parts.size() > 6 && isValidTime(trim(parts[5])) && isValidTime(trim(parts[6]))) {
+        event.setTimes(trim(parts[5]), trim(parts[6]));
+    }
+    return true;
+}
+
+// The event an E journal record describes: E|oldname|name|date|venue|capacity|registered[|start|end]
+static Event eventFromRecord(const vector<string>& f, long long capacity, long long registered) {
+    Event event(f[2], f[3], f[4], static_cast<int>(capacity), static_cast<int>(registered));
+    if (f.size() == 9) event.setTimes(f[7], f[8]);
+    return event;
+}
+
+// Key of one student's hold on one event in holdIds
+static string holdKey(const string& username, const string& eventName) {
+    return username + "|" + eventName;
+}
+
+// Timer handle of a hold whose timer already fired (cancelling it does nothing)
+static const size_t NO_TIMER = static_cast<size_t>(-1);
+
+// Lock the data files for reading: no checkpoint replaces or patches them until the lock is
+// destroyed, so a header, the rows under it and the journal records after it always agree.
+// This session's own checkpoint is finished first: it needs the exclusive lock, and could be
+// holding the pool worker a parallel load would wait for.
+SharedFileLock EventStore::readDataFiles() {
+    finishCheckpoint();
+    return SharedFileLock(CHECKPOINT_LOCK);
+}
+
+// Load both tables (mutations and checkpoints need the whole store)
+void EventStore::ensureLoaded() {
+    ensureEventsLoaded();
+    ensureRegistrationsLoaded();
+}
+
+// The checkpoint sequence in the header of one data file (first line only)
+// A missing file, or one without a header (e.g. from an older version), counts as sequence 0
+static long long fileSequence(const char* path) {
+    string line;
+    ifstream file(path);
+    return getline(file, line) ? headerSequence(line) : 0;
+}
+
+// Read the checkpoint header of each data file
+// Callers hold a SharedFileLock on CHECKPOINT_LOCK (see readDataFiles)
+void EventStore::readFileSequences() {
+    eventsFileSequence = fileSequence(EVENTS_FILE);
+    registrationsFileSequence = fileSequence(REGISTRATIONS_FILE);
+}
+
+// Load events.txt if we haven't done so yet, then replay the journal's event changes
+// Each table is loaded on its own, so a screen that needs only registrations never parses events.txt
+void EventStore::ensureEventsLoaded() {
+    if (eventsLoaded) return;
+    OperationScope scope("EventStore::loadEvents");
+    if (registrationsLoaded) applyNewRecords();    // Bring the other table up to the journal we are about to replay
+    if (eventsLoaded) return;                      // ...which reloaded both
+    watcher.start();
+    eventsLoaded = true;
+    events.clear();
+    seatMaps.clear();
+    venueSchedules.clear();
+    venueSchedulesBuilt = false;
+    studentSchedules.clear();
+    dirtyCounters.clear();
+    dirtyRows.clear();
+
+    // events.txt, its header and the journal are read as one state (until the end of this load)
+    SharedFileLock reading = readDataFiles();
+    readFileSequences();
+
+    bool eventsFileFixed = false;
+    ifstream eventFile(EVENTS_FILE);
+    string line;
+    if (!eventFile.is_open()) {
+        cout << "Error: Could not open events.txt file!" << endl;
+    }
+    while (getline(eventFile, line)) {
+        if (line.empty()) continue;    // Skip empty lines
+        if (line[0] == '#') {          // Checkpoint header
+            headerSequence(line, &eventsFileFixed);
+            continue;
+        }
+        Event event;
+        if (parseEventLine(line, event)) events.push_back(event);
+    }
+    eventFile.close();
+
+    // A fixed-width file keeps its layout, and can be patched in place if every row
+    // has exactly the expected length (i.e. nobody edited it by hand)
+    struct stat info;
+    if (eventsFileFixed) fixedWidthEvents = true;
+    eventsFilePatchable = eventsFileFixed && stat(EVENTS_FILE, &info) == 0 &&
+        static_cast<size_t>(info.st_size) == FIXED_HEADER_LENGTH + events.size() * FIXED_ROW_LENGTH;
+
+    // Changes that were journaled after the file was last checkpointed
+    indexEvents();
+    replayJournal(true, false);
+
+    rebuildStats();
+    reapplyHolds();    // Holds belong to the registrations table, which may be loaded already
+}
+
+// Load registrations.txt (registrations, waitlist and seat holds) if we haven't done so yet
+// File format: username|eventname|registrationdate
+void EventStore::ensureRegistrationsLoaded() {
+    if (registrationsLoaded) return;
+    OperationScope scope("EventStore::loadRegistrations");
+    if (eventsLoaded) applyNewRecords();
+    if (registrationsLoaded) return;
+    watcher.start();
+    registrationsLoaded = true;
+    registrations.clear();
+    seatMaps.clear();
+    studentSchedules.clear();
+    eventStudents.clear();
+    eventStudentsBuilt = false;
+    coRegistrations.clear();
+    coRegistrationsBuilt = false;
+    registrationRates.clear();
+    registrationRatesBuilt = false;
+    waitlist.clear();
+    tombstones.clear();
+    orphansInMemory = false;
+
+    SharedFileLock reading = readDataFiles();
+    readFileSequences();
+
+    // Registrations can be a very large file, so it is parsed in parallel chunks
+    // A missing registrations file just means nobody has registered yet
+    vector<WaitlistEntry> waiting;
+    vector<HoldEntry> held;
+    vector<ParseError> errors;
+    loadRegistrationsParallel(REGISTRATIONS_FILE, registrations, waiting, held, errors);
+    reportParseErrors("registrations.txt", errors);
+    for (size_t i = 0; i < waiting.size(); i = i + 1) {
+        waitlist.join(waiting[i]);
+    }
+    for (auto& hold : holds) {
+        holdTimers.cancel(hold.second.timer);
+    }
+    holds.clear();
+    holdIds.clear();
+    for (size_t i = 0; i < held.size(); i = i + 1) {
+        placeHold(held[i]);
+    }
+
+    replayJournal(false, true);
+    indexRegistrations();
+    if (eventsLoaded) reapplyHolds();
+}
+
+// Rebuild the name → row map of the events table (after rows were inserted or removed in the middle)
+// With duplicate names the first row wins, like a front-to-back search would
+void EventStore::indexEvents() {
+    changeVersion = changeVersion + 1;
+    eventPositions.clear();
+    eventPositions.reserve(events.size());
+    for (size_t i = 0; i < events.size(); i = i + 1) {
+        eventPositions.emplace(events[i].getEventName(), i);
+    }
+}
+
+// Rebuild the username → rows map of the registrations table
+void EventStore::indexRegistrations() {
+    changeVersion = changeVersion + 1;
+    registrationsRebuilt = true;
+    registrationsByStudent.clear();
+    for (size_t i = 0; i < registrations.size(); i = i + 1) {
+        registrationsByStudent[registrations[i].getStudentUsername()].push_back(i);
+    }
+}
+
+// Find a loaded event by name in O(1) (nullptr if there is none)
+Event* EventStore::findLoadedEvent(const string& name) {
+    auto found = eventPositions.find(name);
+    return found == eventPositions.end() ? nullptr : &events[found->second];
+}
+
+// Append a registration and index it under its student
+void EventStore::addRegistration(const Registration& registration) {
+    registrations.push_back(registration);
+    registrationsByStudent[registration.getStudentUsername()].push_back(registrations.size() - 1);
+    dirtyRegistrationChunks.insert((registrations.size() - 1) / ChunkedTable<Registration>::CHUNK_ROWS);
+
+    int row = 0, seat = 0;
+    auto map = seatMaps.find(registration.getEventName());
+    if (map != seatMaps.end() && parseSeat(registration.getSeat(), row, seat)) map->second.take(row, seat);
+    scheduleRegistration(registration, true);
+    if (eventStudentsBuilt) eventStudents[registration.getEventName()].add(studentId(registration.getStudentUsername()));
+    if (coRegistrationsBuilt) {
+        coRegistrations.addRegistration(registration.getEventName(),
+                                        otherEventsOf(registration.getStudentUsername(), registrations.size() - 1));
+    }
+    long long minute = 0;
+    if (registrationRatesBuilt && parseRegistrationTime(registration.getRegistrationDate(), minute)) {
+        registrationRates[registration.getEventName()].record(minute);
+    }
+}
+
+// Remove one registration row
+// What it does: Moves the last row into the gap instead of shifting every later row, so only
+// two students' index lists change: the owner loses the row, and the moved row's owner has
+// its position rewritten in place (their list keeps its order).
+void EventStore::eraseRegistration(size_t row) {
+    int seatRow = 0, seat = 0;
+    auto map = seatMaps.find(registrations[row].getEventName());
+    if (map != seatMaps.end() && parseSeat(registrations[row].getSeat(), seatRow, seat)) map->second.release(seatRow, seat);
+    scheduleRegistration(registrations[row], false);
+    auto members = eventStudents.find(registrations[row].getEventName());
+    if (members != eventStudents.end()) members->second.remove(studentId(registrations[row].getStudentUsername()));
+    if (coRegistrationsBuilt) {
+        coRegistrations.removeRegistration(registrations[row].getEventName(),
+                                           otherEventsOf(registrations[row].getStudentUsername(), row));
+    }
+
+    vector<size_t>& mine = registrationsByStudent[registrations[row].getStudentUsername()];
+    mine.erase(find(mine.begin(), mine.end(), row));
+    if (mine.empty()) registrationsByStudent.erase(registrations[row].getStudentUsername());
+
+    size_t last = registrations.size() - 1;
+    dirtyRegistrationChunks.insert(row / ChunkedTable<Registration>::CHUNK_ROWS);
+    dirtyRegistrationChunks.insert(last / ChunkedTable<Registration>::CHUNK_ROWS);
+    if (row != last) {
+        vector<size_t>& moved = registrationsByStudent[registrations[last].getStudentUsername()];
+        *find(moved.begin(), moved.end(), last) = row;
+        registrations[row] = move(registrations[last]);
+    }
+    registrations.pop_back();
+}
+
+// An event was renamed: re-key everything the registrations side files under its name
+// What it does: Its registrations take the new name (one pass over the table - renames are
+// rare), and its student set, co-registration counts, sign-up rates, holds and waitlist
+// move along with them, so no index is left under the old name. Its seat map and the
+// student timetables are rebuilt from the registrations on next use.
+void EventStore::renameEventIndexes(const string& oldName, const string& newName) {
+    if (oldName == newName) return;
+    for (size_t i = 0; i < registrations.size(); i = i + 1) {
+        if (registrations[i].getEventName() != oldName) continue;
+        registrations[i].setEventName(newName);
+        dirtyRegistrationChunks.insert(i / ChunkedTable<Registration>::CHUNK_ROWS);
+    }
+    changeVersion = changeVersion + 1;
+    auto members = eventStudents.find(oldName);
+    if (members != eventStudents.end()) {
+        RoaringBitmap students = move(members->second);
+        eventStudents.erase(members);
+        eventStudents[newName] = move(students);
+    }
+    coRegistrations.renameEvent(oldName, newName);
+    auto rate = registrationRates.find(oldName);
+    if (rate != registrationRates.end()) {
+        RateWindow window = move(rate->second);
+        registrationRates.erase(rate);
+        registrationRates[newName] = move(window);
+    }
+    seatMaps.erase(oldName);
+    seatMaps.erase(newName);
+    studentSchedules.clear();
+    moveHolds(oldName, newName);
+    waitlist.renameEvent(oldName, newName);
+}
+
+// Split a journal record into its fields and check their count and numbers
+// 'first' and 'second' receive the two numbers of an E record (capacity, registered)
+// or a W record (priority, waitlist sequence); 'first' gets the expiry of an H record
+static bool parseRecord(const JournalRecord& record, vector<string>& f, long long& first, long long& second) {
+    f = split(record.text, '|');
+    string type = f.empty() ? "" : f[0];
+    return record.sequence > 0 &&
+        ((type == "E" && (f.size() == 7 || (f.size() == 9 && isValidTime(f[7]) && isValidTime(f[8]))) &&
+          readNumber(f[5], first) && readNumber(f[6], second)) ||
+         (type == "D" && f.size() == 2) ||
+         (type == "R" && (f.size() == 4 || (f.size() == 5 && !f[4].empty()))) ||
+         (type == "X" && f.size() == 3) ||
+         (type == "W" && f.size() == 6 && readNumber(f[4], first) && readNumber(f[5], second)) ||
+         (type == "L" && f.size() == 3) ||
+         (type == "H" && f.size() == 5 && readNumber(f[4], first)) ||
+         (type == "U" && f.size() == 3));
+}
+
+// Catch up with other sessions
+// What it does: Asks the watcher whether anything in data/ changed, and if so applies the
+// journal records appended since the last look. A new events.txt written by somebody
+// else may not have our row order, so it is no longer patched in place.
+void EventStore::refresh() {
+    if (!eventsLoaded && !registrationsLoaded) return;
+    if (eventsLoaded) expireHolds();
+    vector<string> changed = watcher.changedFiles();
+    if (changed.empty()) return;
+    OperationScope scope("EventStore::refresh");
+
+    applyNewRecords();
+
+    long long eventsBefore = eventsFileSequence;
+    {
+        SharedFileLock reading(CHECKPOINT_LOCK);
+        readFileSequences();
+    }
+    if (eventsFileSequence != eventsBefore && eventsFileSequence != lastCheckpointSequence) {
+        eventsFilePatchable = false;
+    }
+}
+
+// Apply other sessions' new journal records to whichever tables are loaded
+// If another session checkpointed records before we read them, they are only in the
+// data files now, so everything is loaded again instead
+void EventStore::applyNewRecords() {
+    bool missed = false;
+    vector<JournalRecord> records = journal.readNewRecords(missed);
+    if (missed) {
+        cout << "Note: Data was checkpointed by another session - reloading." << endl;
+        reload();
+        return;
+    }
+    for (size_t i = 0; i < records.size(); i = i + 1) {
+        vector<string> f;
+        long long first = 0, second = 0;
+        if (parseRecord(records[i], f, first, second)) applyRecord(f, first, second);
+    }
+}
+
+// Apply one journal record to the loaded tables, statistics and indexes
+// (the same changes the mutation methods make for this session's own records)
+void EventStore::applyRecord(const vector<string>& f, long long first, long long second) {
+    changeVersion = changeVersion + 1;
+    const string& type = f[0];
+    if (type == "E") {
+        if (registrationsLoaded && tombstones.count(f[2]) > 0) purgeOrphans();
+        if (registrationsLoaded && !f[1].empty()) renameEventIndexes(f[1], f[2]);    // Only if renamed
+        if (!eventsLoaded) return;
+        Event updated = eventFromRecord(f, first, second);
+        Event* existing = f[1].empty() ? nullptr : findLoadedEvent(f[1]);
+        seatMaps.erase(f[1]);    // The venue may have changed: rebuilt on next use
+        seatMaps.erase(f[2]);
+        if (existing != nullptr) {
+            studentSchedules.clear();    // So may the time
+            size_t row = static_cast<size_t>(existing - events.data());
+            stats.removeEvent(*existing);
+            unscheduleEvent(*existing);
+            updated.setHeldSeats(existing->getHeldSeats());
+            *existing = updated;
+            stats.addEvent(updated);
+            scheduleEvent(updated);
+            dirtyRows.insert(row);
+            if (f[1] != f[2]) {
+                eventPositions.erase(f[1]);
+                eventPositions.emplace(f[2], row);
+            }
+        } else {
+            events.push_back(updated);
+            eventPositions.emplace(f[2], events.size() - 1);
+            stats.addEvent(updated);
+            scheduleEvent(updated);
+            eventsFilePatchable = false;
+        }
+    } else if (type == "D") {
+        seatMaps.erase(f[1]);
+        studentSchedules.clear();
+        eventStudents.erase(f[1]);
+        Event* deleted = eventsLoaded ? findLoadedEvent(f[1]) : nullptr;
+        if (deleted != nullptr) {
+            stats.removeEvent(*deleted);
+            unscheduleEvent(*deleted);
+            events.erase(events.begin() + (deleted - events.data()));
+            indexEvents();
+            eventsFilePatchable = false;
+            reapplyHolds();    // Drops the deleted event's holds
+        }
+        if (registrationsLoaded) {
+            waitlist.removeEvent(f[1]);
+            tombstones.insert(f[1]);
+            orphansInMemory = true;
+        }
+    } else if (type == "R" || type == "X") {
+        Event* event = eventsLoaded ? findLoadedEvent(f[2]) : nullptr;
+        if (event != nullptr) {
+            stats.removeEvent(*event);
+            if (type == "R") event->registerStudent();
+            else event->unregisterStudent();
+            stats.addEvent(*event);
+            dirtyCounters.insert(static_cast<size_t>(event - events.data()));
+        }
+        if (registrationsLoaded && type == "R") {
+            consumeHold(f[1], f[2]);    // Registering uses the student's hold, whichever session made it
+            waitlist.leave(f[1], f[2]);    // ...and their place on the waitlist
+            addRegistration(Registration(f[1], f[2], f[3], f.size() > 4 ? f[4] : ""));
+        } else if (registrationsLoaded) {
+            size_t row = findRegistration(f[1], f[2]);
+            if (row != registrations.size()) eraseRegistration(row);
+        }
+    } else if (type == "W" && registrationsLoaded) {
+        WaitlistEntry entry;
+        entry.username = f[1];
+        entry.eventName = f[2];
+        entry.joinDate = f[3];
+        entry.priority = static_cast<int>(first);
+        entry.sequence = second;
+        waitlist.join(entry);
+    } else if (type == "L" && registrationsLoaded) {
+        waitlist.leave(f[1], f[2]);
+    } else if (type == "H" && registrationsLoaded) {
+        placeHold(HoldEntry{ f[1], f[2], f[3], first });
+    } else if (type == "U" && registrationsLoaded) {
+        consumeHold(f[1], f[2]);
+    }
+}
+
+// Apply data/journal.txt on top of a freshly loaded table (events, registrations or both)
+// What it does: A record changes a file's data only if it is newer than that file's
+// checkpoint, so a crash between replacing events.txt and registrations.txt (or before the
+// journal was trimmed) never applies a change twice.
+// Record formats (after the sequence number):
+//   E|oldname|name|date|venue|capacity|registered[|start|end]   event added (oldname empty) or edited
+//   D|name                                          event deleted
+//   R|username|eventname|date[|seat]                registered (takes a seat; "row-seat" if assigned;
+//                                                   also ends the student's hold and waitlist place)
+//   X|username|eventname                            unregistered (frees a seat)
+//   W|username|eventname|date|priority|sequence     joined a waitlist
+//   L|username|eventname                            left a waitlist (or was promoted)
+//   H|username|eventname|date|expiresat             held a seat, or renewed the hold (expiry: time())
+//   U|username|eventname                            released a hold (registering also ends it)
+void EventStore::replayJournal(bool toEventsTable, bool toRegistrationsTable) {
+    vector<JournalRecord> records = journal.readAll();
+    vector<ParseError> errors;
+    long long lastSequence = max(eventsFileSequence, registrationsFileSequence);
+
+    // Removed registrations are only marked here and dropped in one pass at the end
+    vector<bool> removed(registrations.size(), false);
+    unordered_map<string, size_t> position;    // "user|event" → index, built on the first X
+    bool positionsBuilt = false;
+
+    for (size_t i = 0; i < records.size(); i = i + 1) {
+        const JournalRecord& record = records[i];
+        vector<string> f;
+        long long first = 0, second = 0;
+        if (!parseRecord(record, f, first, second)) {
+            errors.push_back(ParseError{ i + 1, record.text });
+            continue;
+        }
+        lastSequence = max(lastSequence, record.sequence);
+        const string& type = f[0];
+        bool toEvents = toEventsTable && record.sequence > eventsFileSequence;
+        bool toRegistrations = toRegistrationsTable && record.sequence > registrationsFileSequence;
+
+        if (type == "E" && toRegistrations && !f[1].empty() && f[1] != f[2]) {
+            renameEventIndexes(f[1], f[2]);
+            position.clear();    // Keyed by the old name: rebuilt on the next X
+            positionsBuilt = false;
+        }
+        if (type == "E" && toEvents) {
+            Event updated = eventFromRecord(f, first, second);
+            Event* existing = f[1].empty() ? nullptr : findLoadedEvent(f[1]);
+            if (existing != nullptr) {
+                size_t row = static_cast<size_t>(existing - events.data());
+                *existing = updated;
+                dirtyRows.insert(row);
+                if (f[1] != f[2]) {
+                    eventPositions.erase(f[1]);
+                    eventPositions.emplace(f[2], row);
+                }
+            } else {
+                events.push_back(updated);
+                eventPositions.emplace(f[2], events.size() - 1);
+                eventsFilePatchable = false;
+            }
+        } else if (type == "D") {
+            Event* deleted = toEvents ? findLoadedEvent(f[1]) : nullptr;
+            if (deleted != nullptr) {
+                events.erase(events.begin() + (deleted - events.data()));
+                indexEvents();    // Later rows moved up
+                eventsFilePatchable = false;
+            }
+            if (toRegistrations) {
+                for (size_t r = 0; r < registrations.size(); r = r + 1) {
+                    if (registrations[r].getEventName() == f[1]) removed[r] = true;
+                }
+                waitlist.removeEvent(f[1]);
+            }
+        } else if (type == "R" || type == "X") {
+            if (toEvents) {
+                Event* event = findLoadedEvent(f[2]);
+                if (event != nullptr) {
+                    if (type == "R") event->registerStudent();
+                    else event->unregisterStudent();
+                    dirtyCounters.insert(static_cast<size_t>(event - events.data()));
+                }
+            }
+            if (toRegistrations && type == "R") {
+                consumeHold(f[1], f[2]);
+                waitlist.leave(f[1], f[2]);
+                registrations.push_back(Registration(f[1], f[2], f[3], f.size() > 4 ? f[4] : ""));
+                removed.push_back(false);
+                if (positionsBuilt) position[f[1] + "|" + f[2]] = registrations.size() - 1;
+            } else if (toRegistrations) {
+                if (!positionsBuilt) {
+                    for (size_t r = 0; r < registrations.size(); r = r + 1) {
+                        if (!removed[r]) {
+                            position[registrations[r].getStudentUsername() + "|" + registrations[r].getEventName()] = r;
+                        }
+                    }
+                    positionsBuilt = true;
+                }
+                auto found = position.find(f[1] + "|" + f[2]);
+                if (found != position.end()) {
+                    removed[found->second] = true;
+                    position.erase(found);
+                }
+            }
+        } else if (type == "W" && toRegistrations) {
+            WaitlistEntry entry;
+            entry.username = f[1];
+            entry.eventName = f[2];
+            entry.joinDate = f[3];
+            entry.priority = static_cast<int>(first);
+            entry.sequence = second;
+            waitlist.join(entry);
+        } else if (type == "L" && toRegistrations) {
+            waitlist.leave(f[1], f[2]);
+        } else if (type == "H" && toRegistrations) {
+            placeHold(HoldEntry{ f[1], f[2], f[3], first });
+        } else if (type == "U" && toRegistrations) {
+            consumeHold(f[1], f[2]);
+        }
+    }
+
+    // Drop the registrations that were removed during the replay
+    size_t kept = 0;
+    for (size_t r = 0; r < registrations.size(); r = r + 1) {
+        if (!removed[r]) {
+            if (kept != r) registrations[kept] = move(registrations[r]);
+            kept = kept + 1;
+        }
+    }
+    registrations.resize(kept);
+
+    // Both tables replay the same journal; its bad lines are reported once
+    if (!journalErrorsReported) reportParseErrors("journal.txt", errors);
+    journalErrorsReported = true;
+    journal.resetCounters(records.size(), lastSequence);
+}
+
+// Drop registrations of deleted events from memory
+// One pass handles any number of deletions, so it only runs when somebody needs the table
+void EventStore::purgeOrphans() {
+    if (!orphansInMemory) return;
+    orphansInMemory = false;
+    if (tombstones.empty()) return;
+
+    size_t kept = 0;
+    for (size_t i = 0; i < registrations.size(); i = i + 1) {
+        if (tombstones.count(registrations[i].getEventName()) == 0) {
+            if (kept != i) registrations[kept] = move(registrations[i]);
+            kept = kept + 1;
+        }
+    }
+    registrations.resize(kept);
+    for (const string& deleted : tombstones) {
+        coRegistrations.removeEvent(deleted);
+        registrationRates.erase(deleted);
+    }
+    tombstones.clear();
+    indexRegistrations();
+}
+
+// Tell the user about lines that were skipped while loading
+// Only the first few are printed so a badly damaged file doesn't flood the screen
+void EventStore::reportParseErrors(const string& fileName, const vector<ParseError>& errors) {
+    const size_t maxShown = 10;
+    for (size_t i = 0; i < errors.size() && i < maxShown; i = i + 1) {
+        cout << "Warning: " << fileName << " line " << errors[i].lineNumber
+             << " is malformed and was skipped: " << errors[i].text << endl;
+    }
+    if (errors.size() > maxShown) {
+        cout << "Warning: " << (errors.size() - maxShown) << " more malformed line(s) in "
+             << fileName << " were skipped" << endl;
+    }
+}
+
+// Recompute the statistics from the whole table (only after a full load/replace)
+void EventStore::rebuildStats() {
+    stats.clear();
+    for (size_t i = 0; i < events.size(); i = i + 1) {
+        stats.addEvent(events[i]);
+    }
+}
+
+// Read access
+const vector<Event>& EventStore::getEvents() {
+    ensureEventsLoaded();
+    return events;
+}
+
+const vector<Registration>& EventStore::getRegistrations() {
+    ensureRegistrationsLoaded();
+    purgeOrphans();
+    return registrations;
+}
+
+const EventStats& EventStore::getStats() {
+    ensureEventsLoaded();
+    return stats;
+}
+
+const Waitlist& EventStore::getWaitlist() {
+    ensureRegistrationsLoaded();
+    return waitlist;
+}
+
+// Take a read snapshot
+// What it does: Returns the published snapshot if nothing changed since it was taken.
+// Otherwise builds the next version: the events table and statistics are copied (one row
+// per event, small next to the registrations), and the registrations reuse every chunk of
+// the previous version except the ones addRegistration/eraseRegistration marked dirty.
+// The new version is then published with one atomic pointer swap; readers still holding
+// an older one keep it alive until they let go.
+shared_ptr<const StoreSnapshot> EventStore::snapshot() {
+    ensureLoaded();
+    purgeOrphans();
+    shared_ptr<const StoreSnapshot> current = atomic_load(&published);
+    if (current != nullptr && current->version == changeVersion) return current;
+
+    OperationScope scope("EventStore::snapshot");
+    auto next = make_shared<StoreSnapshot>();
+    next->version = changeVersion;
+    static const ChunkedTable<Event> noEvents;
+    static const ChunkedTable<Registration> noRegistrations;
+    next->events = ChunkedTable<Event>::rebuild(noEvents, events, {}, true);
+    next->registrations = ChunkedTable<Registration>::rebuild(
+        current != nullptr ? current->registrations : noRegistrations, registrations,
+        dirtyRegistrationChunks, registrationsRebuilt || current == nullptr);
+    next->stats = stats;
+    dirtyRegistrationChunks.clear();
+    registrationsRebuilt = false;
+
+    shared_ptr<const StoreSnapshot> frozen = next;
+    atomic_store(&published, frozen);
+    return frozen;
+}
+
+shared_ptr<const StoreSnapshot> EventStore::publishedSnapshot() const {
+    return atomic_load(&published);
+}
+
+// One student's registrations, read through the per-student index
+vector<Registration> EventStore::getRegistrationsFor(const string& username) {
+    ensureRegistrationsLoaded();
+    purgeOrphans();
+    vector<Registration> mine;
+    auto found = registrationsByStudent.find(username);
+    if (found == registrationsByStudent.end()) return mine;
+    mine.reserve(found->second.size());
+    for (size_t row : found->second) mine.push_back(registrations[row]);
+    return mine;
+}
+
+bool EventStore::isRegistered(const string& username, const string& eventName) {
+    ensureRegistrationsLoaded();
+    purgeOrphans();
+    return findRegistration(username, eventName) != registrations.size();
+}
+
+// Row of a student's registration for an event ('registrations.size()' if there is none)
+// Only that student's own rows are looked at
+size_t EventStore::findRegistration(const string& username, const string& eventName) const {
+    auto found = registrationsByStudent.find(username);
+    if (found == registrationsByStudent.end()) return registrations.size();
+    for (size_t row : found->second) {
+        if (registrations[row].getEventName() == eventName) return row;
+    }
+    return registrations.size();
+}
+
+// Fetch one event without loading events.txt
+// What it does: Binary-searches the index for the event's line and parses just that line,
+// then applies the journal records newer than events.txt that touch this event (edits,
+// renames, deletes, seat changes). An index that doesn't match events.txt is ignored and
+// the whole table is loaded instead.
+bool EventStore::lookupEvent(const string& name, Event& found) {
+    OperationScope scope("EventStore::lookupEvent");
+    if (!eventsLoaded) {
+        SharedFileLock reading = readDataFiles();    // The index, the row and the journal agree
+        readFileSequences();
+
+        long long indexSequence = 0;
+        long long offset = -1;
+        bool exists = false;
+        bool usable = lookupEventOffset(EVENTS_INDEX_FILE, name, indexSequence, offset) &&
+                      indexSequence == eventsFileSequence;
+        if (usable && offset >= 0) {
+            string line;
+            usable = readLineAt(EVENTS_FILE, offset, line) && parseEventLine(line, found) &&
+                     found.getEventName() == name;
+            exists = usable;
+        }
+
+        if (usable) {
+            vector<JournalRecord> records = journal.readAll();
+            for (size_t i = 0; i < records.size(); i = i + 1) {
+                vector<string> f;
+                long long capacity = 0, registered = 0;
+                if (records[i].sequence <= eventsFileSequence || !parseRecord(records[i], f, capacity, registered)) continue;
+                if (f[0] == "E") {
+                    if (f[2] == name) {
+                        found = eventFromRecord(f, capacity, registered);
+                        exists = true;
+                    } else if (f[1] == name) {
+                        exists = false;    // Renamed to something else
+                    }
+                } else if (f[0] == "D" && f[1] == name) {
+                    exists = false;
+                } else if (exists && f[0] == "R" && f[2] == name) {
+                    found.registerStudent();
+                } else if (exists && f[0] == "X" && f[2] == name) {
+                    found.unregisterStudent();
+                }
+            }
+            return exists;
+        }
+    }
+
+    ensureEventsLoaded();
+    Event* loaded = findLoadedEvent(name);
+    if (loaded == nullptr) return false;
+    found = *loaded;
+    return true;
+}
+
+// Replace the whole events table (written straight to the data files by a checkpoint)
+bool EventStore::saveEvents(const vector<Event>& newEvents) {
+    ensureLoaded();
+    events = newEvents;
+    indexEvents();
+    rebuildStats();
+    reapplyHolds();
+    seatMaps.clear();
+    venueSchedules.clear();
+    venueSchedulesBuilt = false;
+    studentSchedules.clear();
+    eventsFilePatchable = false;
+    return checkpoint(true);
+}
+
+// Replace the whole registrations table
+bool EventStore::saveRegistrations(const vector<Registration>& newRegistrations) {
+    ensureLoaded();
+    registrations = newRegistrations;
+    indexRegistrations();
+    seatMaps.clear();
+    studentSchedules.clear();
+    eventStudents.clear();
+    eventStudentsBuilt = false;
+    coRegistrations.clear();
+    coRegistrationsBuilt = false;
+    registrationRates.clear();
+    registrationRatesBuilt = false;
+    orphansInMemory = true;
+    return checkpoint(true);
+}
+
+// Add a new event at the end of the table
+// Refused (false) if an event with the same name, ignoring case, exists once other
+// sessions' records are applied (commitChecked()), so two sessions can't both add it
+bool EventStore::addEvent(const Event& event) {
+    ensureLoaded();
+    string lowerName = toLower(event.getEventName());
+    return commitChecked([&](vector<string>& records) {
+        for (size_t i = 0; i < events.size(); i = i + 1) {
+            if (toLower(events[i].getEventName()) == lowerName) return false;
+        }
+        // Reusing the name of a deleted event: its old registrations must go before new ones arrive
+        if (tombstones.count(event.getEventName()) > 0) purgeOrphans();
+
+        events.push_back(event);
+        eventPositions.emplace(event.getEventName(), events.size() - 1);
+        stats.addEvent(event);
+        scheduleEvent(event);
+        eventsFilePatchable = false;    // A new row: the next checkpoint rewrites events.txt
+        records.push_back("E||" + event.toFileFormat());
+        return true;
+    });
+}
+
+// Overwrite one event with an edited copy
+// If the edit freed seats (capacity went up), waitlisted students are promoted right away
+// and journaled together with the edit. The edit is applied once other sessions' records
+// are (commitChecked()), keeping the registered count they reached, so promotions only
+// take seats that are still free. The edit is refused ('problem' says why) if the event is
+// gone, the new name is taken, or the capacity is below the seats taken by then.
+bool EventStore::updateEvent(size_t index, const Event& updated, vector<WaitlistEntry>* promoted, string* problem) {
+    ensureLoaded();
+    if (index >= events.size()) return false;
+    if (tombstones.count(updated.getEventName()) > 0) purgeOrphans();
+
+    string oldName = events[index].getEventName();
+    string refusal;
+    bool saved = commitChecked([&](vector<string>& records) {
+        refusal.clear();
+        Event* current = findLoadedEvent(oldName);
+        if (current == nullptr) {
+            refusal = "Event was deleted or renamed by another session";
+            return false;
+        }
+        if (toLower(updated.getEventName()) != toLower(oldName)) {
+            for (size_t i = 0; i < events.size(); i = i + 1) {
+                if (toLower(events[i].getEventName()) == toLower(updated.getEventName())) {
+                    refusal = "Event with this name already exists";
+                    return false;
+                }
+            }
+        }
+        int taken = current->getRegisteredCount() + current->getHeldSeats();
+        if (updated.getCapacity() < taken) {
+            refusal = "New capacity cannot be less than the " + to_string(taken) + " seat(s) registered or held";
+            return false;
+        }
+        size_t row = static_cast<size_t>(current - events.data());
+        Event edited = updated;
+        edited.setRegisteredCount(current->getRegisteredCount());
+        records.push_back("E|" + oldName + "|" + edited.toFileFormat());
+
+        int held = current->getHeldSeats();
+        seatMaps.erase(oldName);
+        seatMaps.erase(edited.getEventName());
+        studentSchedules.clear();    // Registrants' timetables are rebuilt with the new date/time
+        if (oldName != edited.getEventName()) {
+            eventPositions.erase(oldName);
+            eventPositions.emplace(edited.getEventName(), row);
+            renameEventIndexes(oldName, edited.getEventName());
+        }
+        stats.removeEvent(events[row]);
+        unscheduleEvent(events[row]);
+        events[row] = edited;
+        events[row].setHeldSeats(held);
+        stats.addEvent(edited);
+        scheduleEvent(edited);
+        dirtyRows.insert(row);
+
+        promoteFromWaitlist(events[row], promoted, records);
+        return true;
+    });
+    if (problem != nullptr) *problem = refusal;
+    return saved;
+}
+
+// Delete an event
+// What it does: Journals one "D|name" record and hides the event right away.
+// The event's registrations disappear from reads on the next purge (one pass for any
+// number of deletions), and from the data files at the next checkpoint.
+// The event is found by name once other sessions' records are applied (commitChecked()):
+// false if another session deleted or renamed it meanwhile.
+bool EventStore::removeEvent(size_t index) {
+    OperationScope scope("EventStore::removeEvent");
+    ensureLoaded();
+    if (index >= events.size()) return false;
+
+    string deletedEventName = events[index].getEventName();
+    return commitChecked([&](vector<string>& records) {
+        Event* deleted = findLoadedEvent(deletedEventName);
+        if (deleted == nullptr) return false;
+        seatMaps.erase(deletedEventName);
+        studentSchedules.clear();
+        eventStudents.erase(deletedEventName);
+        stats.removeEvent(*deleted);
+        unscheduleEvent(*deleted);
+        events.erase(events.begin() + (deleted - events.data()));
+        indexEvents();    // Later rows moved up
+        eventsFilePatchable = false;
+        reapplyHolds();
+        waitlist.removeEvent(deletedEventName);
+        tombstones.insert(deletedEventName);
+        orphansInMemory = true;
+        records.push_back("D|" + deletedEventName);
+        return true;
+    });
+}
+
+// Record a registration and take one seat from the event
+// Callers check for duplicates and free seats first; both are checked again, and the seat
+// is picked, once other sessions' records are applied (commitChecked())
+bool EventStore::registerStudent(const string& username, size_t eventIndex, const string& regDate) {
+    ensureLoaded();
+    if (eventIndex >= events.size()) return false;
+
+    string eventName = events[eventIndex].getEventName();
+    return commitChecked([&](vector<string>& records) {
+        Event* event = findLoadedEvent(eventName);
+        if (event == nullptr || findRegistration(username, eventName) != registrations.size()) return false;
+        if (!consumeHold(username, eventName) && !event->hasAvailableSeats()) return false;
+        stats.removeEvent(*event);
+        event->registerStudent();
+        stats.addEvent(*event);
+        dirtyCounters.insert(static_cast<size_t>(event - events.data()));
+        addRegistration(Registration(username, eventName, regDate, assignSeats(*event, 1)[0]));
+        waitlist.leave(username, eventName);    // Registered now: no longer waiting (R implies it)
+        records.push_back("R|" + registrations.back().toFileFormat());
+        return true;
+    });
+}
+
+// Register for several events at once (all or nothing)
+// What it does: With the journal locked and other sessions' records applied, validates the
+// whole batch, applies it in memory (seats are picked from the up-to-date seat maps), then
+// journals every registration with a single write. If that write fails the saved state is
+// reloaded, so the batch is never half-applied.
+bool EventStore::registerBatch(const string& username, const vector<size_t>& eventIndexes,
+                               const string& regDate, vector<string>& problems) {
+    OperationScope scope("EventStore::registerBatch");
+    ensureLoaded();
+    purgeOrphans();
+    expireHolds();
+
+    // Rows can move while other sessions' records are applied, so the events go by name
+    vector<string> names;
+    for (size_t i = 0; i < eventIndexes.size(); i = i + 1) {
+        size_t index = eventIndexes[i];
+        if (index >= events.size()) {
+            problems.push_back("Event #" + to_string(index + 1) + " does not exist");
+        } else {
+            names.push_back(events[index].getEventName());
+        }
+    }
+    if (!problems.empty() || eventIndexes.empty()) return false;
+
+    vector<string> found;    // Problems found by the last check (it runs again after a reload)
+    bool saved = commitChecked([&](vector<string>& records) {
+        found.clear();
+
+        // Events this student already has (read from their own index list, not the whole table)
+        unordered_set<string> alreadyRegistered;
+        auto mine = registrationsByStudent.find(username);
+        if (mine != registrationsByStudent.end()) {
+            for (size_t row : mine->second) alreadyRegistered.insert(registrations[row].getEventName());
+        }
+
+        // Phase 1: validate everything before touching anything
+        // (including clashes with the student's timetable and between the chosen events)
+        unordered_set<string> chosen;
+        IntervalTree batchTimes;
+        Event clash;
+        long long start = 0, end = 0;
+        string clashName;
+        for (size_t i = 0; i < names.size(); i = i + 1) {
+            const Event* event = findLoadedEvent(names[i]);
+            if (event == nullptr) {
+                found.push_back("'" + names[i] + "' no longer exists");
+            } else if (!chosen.insert(names[i]).second) {
+                found.push_back("'" + names[i] + "' was chosen more than once");
+            } else if (alreadyRegistered.count(names[i]) > 0) {
+                found.push_back("Already registered for '" + names[i] + "'");
+            } else if (!event->hasAvailableSeats() && holdIds.count(holdKey(username, names[i])) == 0) {
+                found.push_back("'" + names[i] + "' is full");
+            } else if (findScheduleClash(username, *event, clash)) {
+                found.push_back("'" + names[i] + "' clashes with '" + clash.getEventName() + "' (" +
+                                describeTimeSlot(clash) + ")");
+            } else if (eventInterval(*event, start, end)) {
+                if (batchTimes.firstOverlapping(start, end, clashName)) {
+                    found.push_back("'" + names[i] + "' clashes with '" + clashName + "', also chosen");
+                }
+                batchTimes.insert(start, end, names[i]);
+            }
+        }
+        if (!found.empty()) return false;
+
+        // Phase 2: apply in memory
+        for (size_t i = 0; i < names.size(); i = i + 1) {
+            Event* event = findLoadedEvent(names[i]);
+            consumeHold(username, names[i]);
+            stats.removeEvent(*event);
+            event->registerStudent();
+            stats.addEvent(*event);
+            dirtyCounters.insert(static_cast<size_t>(event - events.data()));
+            addRegistration(Registration(username, names[i], regDate, assignSeats(*event, 1)[0]));
+            waitlist.leave(username, names[i]);
+            records.push_back("R|" + registrations.back().toFileFormat());
+        }
+        return true;
+    });
+
+    // Phase 3: one journal write for the whole batch (made by commitChecked)
+    if (saved) return true;
+    if (found.empty()) found.push_back("Could not save the data files");
+    problems.insert(problems.end(), found.begin(), found.end());
+    return false;
+}
+
+// Admit a batch of students to one event
+// What it does: With the journal locked and every other session's records applied, walks
+// the requests in arrival order, granting a seat to each student who isn't registered yet
+// until the event is full; the rest are turned away before anything is written, so two
+// sessions admitting at once can't oversell the event. The seat count and statistics are
+// updated once for the whole batch, and the granted registrations share one journal write.
+// If that write fails the saved state is reloaded and nobody in the batch is granted.
+vector<AdmissionResult> EventStore::admitBatch(const string& eventName, const vector<SeatRequest>& requests) {
+    OperationScope scope("EventStore::admitBatch");
+    ensureLoaded();
+    purgeOrphans();
+    expireHolds();
+    vector<AdmissionResult> results(requests.size());
+
+    bool saved = commitChecked([&](vector<string>& records) {
+        results.assign(requests.size(), AdmissionResult());
+        Event* event = findLoadedEvent(eventName);
+        if (event == nullptr) {
+            for (size_t i = 0; i < results.size(); i = i + 1) results[i].reason = "Event does not exist";
+            return false;
+        }
+
+        vector<size_t> granted;            // Requests that get a seat, in arrival order
+        unordered_set<string> admitted;    // Students granted in this batch (a double click asks twice)
+        int seatsLeft = event->getAvailableSeats();    // Students holding a seat don't need one of these
+        Event clash;
+        for (size_t i = 0; i < requests.size(); i = i + 1) {
+            const string& username = requests[i].username;
+            if (admitted.count(username) > 0 || findRegistration(username, eventName) != registrations.size()) {
+                results[i].reason = "Already registered";
+            } else if (seatsLeft <= 0 && holdIds.count(holdKey(username, eventName)) == 0) {
+                results[i].reason = "Event is full";
+            } else if (findScheduleClash(username, *event, clash)) {
+                results[i].reason = "Clashes with '" + clash.getEventName() + "' (" + describeTimeSlot(clash) + ")";
+            } else {
+                admitted.insert(username);
+                if (!consumeHold(username, eventName)) seatsLeft = seatsLeft - 1;
+                granted.push_back(i);
+            }
+        }
+        if (granted.empty()) return false;
+
+        // Seats for the whole batch at once (side by side when possible)
+        vector<string> seats = assignSeats(*event, granted.size());
+        for (size_t g = 0; g < granted.size(); g = g + 1) {
+            size_t i = granted[g];
+            addRegistration(Registration(requests[i].username, eventName, requests[i].regDate, seats[g]));
+            waitlist.leave(requests[i].username, eventName);
+            records.push_back("R|" + registrations.back().toFileFormat());
+            results[i].granted = true;
+            results[i].seat = seats[g];
+        }
+
+        stats.removeEvent(*event);
+        event->setRegisteredCount(event->getRegisteredCount() + static_cast<int>(records.size()));
+        stats.addEvent(*event);
+        dirtyCounters.insert(static_cast<size_t>(event - events.data()));
+        return true;
+    });
+
+    for (size_t i = 0; i < results.size() && !saved; i = i + 1) {
+        if (!results[i].granted) continue;
+        results[i].granted = false;
+        results[i].reason = "Could not save the registration";
+    }
+    return results;
+}
+
+// Remove a registration and give the seat back to the event
+// The freed seat goes to the next student on the waitlist before anything is saved,
+// so the unregistration and the promotion land in the same journal write; both are
+// decided once other sessions' records are applied (commitChecked())
+// Returns false if the student wasn't registered for that event
+bool EventStore::unregisterStudent(const string& username, const string& eventName,
+                                   vector<WaitlistEntry>* promoted) {
+    ensureLoaded();
+    purgeOrphans();
+
+    return commitChecked([&](vector<string>& records) {
+        size_t row = findRegistration(username, eventName);
+        if (row == registrations.size()) return false;
+
+        eraseRegistration(row);
+        records.push_back("X|" + username + "|" + eventName);
+
+        Event* event = findLoadedEvent(eventName);
+        if (event != nullptr) {
+            stats.removeEvent(*event);
+            event->unregisterStudent();
+            stats.addEvent(*event);
+            dirtyCounters.insert(static_cast<size_t>(event - events.data()));
+            promoteFromWaitlist(*event, promoted, records);
+        }
+        return true;
+    });
+}
+
+// The clock the hold timers tick by: wall-clock seconds (time()), so every session
+// agrees on when a journaled hold expires
+long long EventStore::holdClock() const {
+    return static_cast<long long>(time(0));
+}
+
+// Hold a seat for a student
+// What it does: Journals an H record with the hold's expiry and takes one seat out of the
+// event's available seats (Event::setHeldSeats); every session applies the record the same
+// way, so a held seat is taken for all of them. Whether a seat is free is decided with the
+// journal locked and other sessions' holds and registrations applied (commitChecked()).
+// The hold becomes a registration when the student confirms.
+bool EventStore::holdSeat(const string& username, const string& eventName, int minutes, string& problem) {
+    ensureLoaded();
+    purgeOrphans();
+    expireHolds();
+
+    HoldEntry hold{ username, eventName, currentDateTime(),
+                    holdClock() + static_cast<long long>(max(1, minutes)) * 60 };
+    problem = "Could not save the hold";
+    return commitChecked([this, &hold, &problem](vector<string>& records) {
+        Event* event = findLoadedEvent(hold.eventName);
+        if (event == nullptr) {
+            problem = "Event does not exist";
+            return false;
+        }
+        if (findRegistration(hold.username, hold.eventName) != registrations.size()) {
+            problem = "Already registered";
+            return false;
+        }
+        // Holding again only renews the hold
+        if (holdIds.count(holdKey(hold.username, hold.eventName)) == 0 && !event->hasAvailableSeats()) {
+            problem = "Event is full";
+            return false;
+        }
+        placeHold(hold);
+        records.push_back("H|" + hold.username + "|" + hold.eventName + "|" + hold.holdDate + "|" +
+                          to_string(hold.expiresAt));
+        return true;
+    });
+}
+
+// Give a held seat back before it expires (it goes to the waitlist, if anybody is waiting)
+bool EventStore::releaseHold(const string& username, const string& eventName) {
+    ensureLoaded();
+    return commitChecked([this, &username, &eventName](vector<string>& records) {
+        if (!consumeHold(username, eventName)) return false;
+        records.push_back("U|" + username + "|" + eventName);
+        Event* event = findLoadedEvent(eventName);
+        if (event != nullptr) promoteFromWaitlist(*event, nullptr, records);
+        return true;
+    });
+}
+
+bool EventStore::hasHold(const string& username, const string& eventName) {
+    ensureLoaded();
+    expireHolds();
+    return holdIds.count(holdKey(username, eventName)) > 0;
+}
+
+// Let every hold whose time is up go
+// What it does: Advances the timer wheel to the current second (only the slots that are due
+// are visited). Another session may have renewed or used one of those holds meanwhile, so
+// the rest happens with the journal locked and its records applied: each hold that is still
+// due frees its seat and offers it to the event's waitlist. Every session expires the holds
+// it knows about by itself (the expiry is in the H record, nothing more is journaled), and
+// whichever session gets the lock first promotes; the others then find no free seat.
+// The promotions of all expired holds are journaled with one write.
+void EventStore::expireHolds() {
+    if (holds.empty()) return;
+    vector<unsigned long long> expired;
+    holdTimers.advance(holdClock(), expired);
+    if (expired.empty()) return;
+    for (size_t i = 0; i < expired.size(); i = i + 1) {
+        auto found = holds.find(expired[i]);
+        if (found != holds.end()) found->second.timer = NO_TIMER;    // Fired: the handle is no longer ours
+    }
+
+    commitChecked([this, &expired](vector<string>& records) {
+        long long now = holdClock();
+        for (size_t i = 0; i < expired.size(); i = i + 1) {
+            auto found = holds.find(expired[i]);
+            if (found == holds.end() || found->second.expiresAt > now) continue;    // Used, released or renewed
+            string eventName = found->second.eventName;
+            removeHold(expired[i]);
+            Event* event = findLoadedEvent(eventName);
+            if (event != nullptr) promoteFromWaitlist(*event, nullptr, records);
+        }
+        return true;
+    });
+}
+
+// Start a hold, or renew the student's hold on that event, and schedule its expiry
+// (used for this session's holds and for H records; a hold already past its expiry is
+// not started, e.g. one read back from an old checkpoint)
+void EventStore::placeHold(const HoldEntry& entry) {
+    auto existing = holdIds.find(holdKey(entry.username, entry.eventName));
+    if (existing != holdIds.end()) {
+        SeatHold& hold = holds[existing->second];
+        holdTimers.cancel(hold.timer);
+        hold.holdDate = entry.holdDate;
+        hold.expiresAt = entry.expiresAt;
+        hold.timer = holdTimers.schedule(existing->second, entry.expiresAt);
+        return;
+    }
+    if (entry.expiresAt <= holdClock()) return;
+
+    unsigned long long id = nextHoldId;
+    nextHoldId = nextHoldId + 1;
+    SeatHold hold;
+    hold.username = entry.username;
+    hold.eventName = entry.eventName;
+    hold.holdDate = entry.holdDate;
+    hold.expiresAt = entry.expiresAt;
+    hold.timer = holdTimers.schedule(id, entry.expiresAt);
+    holds.emplace(id, hold);
+    holdIds.emplace(holdKey(entry.username, entry.eventName), id);
+    Event* event = findLoadedEvent(entry.eventName);
+    if (event != nullptr) event->setHeldSeats(event->getHeldSeats() + 1);
+    changeVersion = changeVersion + 1;
+}
+
+// End a student's hold: the held seat is released so the caller can take it or pass it on
+// (false if they held nothing)
+bool EventStore::consumeHold(const string& username, const string& eventName) {
+    auto found = holdIds.find(holdKey(username, eventName));
+    if (found == holdIds.end()) return false;
+    removeHold(found->second);
+    return true;
+}
+
+// Forget one hold and give its seat back to the event
+void EventStore::removeHold(unsigned long long id) {
+    auto found = holds.find(id);
+    if (found == holds.end()) return;
+    holdTimers.cancel(found->second.timer);
+    Event* event = findLoadedEvent(found->second.eventName);
+    if (event != nullptr && event->getHeldSeats() > 0) event->setHeldSeats(event->getHeldSeats() - 1);
+    holdIds.erase(holdKey(found->second.username, found->second.eventName));
+    holds.erase(found);
+    changeVersion = changeVersion + 1;
+}
+
+// An event was renamed: its holds follow it
+void EventStore::moveHolds(const string& oldName, const string& newName) {
+    if (oldName == newName) return;
+    for (auto& entry : holds) {
+        if (entry.second.eventName != oldName) continue;
+        holdIds.erase(holdKey(entry.second.username, oldName));
+        entry.second.eventName = newName;
+        holdIds[holdKey(entry.second.username, newName)] = entry.first;
+    }
+}
+
+// Recount every event's held seats from the holds (after the events table was reloaded or
+// replaced); holds on events that no longer exist are dropped
+void EventStore::reapplyHolds() {
+    for (size_t i = 0; i < events.size(); i = i + 1) {
+        events[i].setHeldSeats(0);
+    }
+    for (auto it = holds.begin(); it != holds.end();) {
+        Event* event = findLoadedEvent(it->second.eventName);
+        if (event != nullptr) {
+            event->setHeldSeats(event->getHeldSeats() + 1);
+            ++it;
+        } else {
+            holdTimers.cancel(it->second.timer);
+            holdIds.erase(holdKey(it->second.username, it->second.eventName));
+            it = holds.erase(it);
+        }
+    }
+}
+
+// Read data/venues.txt (once): Venue|rows|seats per row
+// A missing file just means no venue has numbered seats
+void EventStore::loadVenueLayouts() {
+    if (venuesLoaded) return;
+    venuesLoaded = true;
+    venueLayouts.clear();
+    ifstream file(VENUES_FILE);
+    string line;
+    while (getline(file, line)) {
+        if (trim(line).empty() || trim(line)[0] == '#') continue;
+        vector<string> parts = split(line, '|');
+        if (parts.size() != 3 || !isNumeric(trim(parts[1])) || !isNumeric(trim(parts[2])) ||
+            trim(parts[1]).size() > 4 || trim(parts[2]).size() > 4) {
+            cout << "Warning: venues.txt line is malformed and was skipped: " << line << endl;
+            continue;
+        }
+        SeatLayout layout;
+        layout.rows = stoi(trim(parts[1]));
+        layout.seatsPerRow = stoi(trim(parts[2]));
+        venueLayouts[trim(parts[0])] = layout;
+    }
+}
+
+// The seat map of an event (nullptr if its venue has no numbered seats)
+// What it does: Built the first time it is needed by marking the seat of every registration
+// for the event; after that addRegistration/eraseRegistration keep it current.
+SeatMap* EventStore::seatMapFor(const Event& event) {
+    auto cached = seatMaps.find(event.getEventName());
+    if (cached != seatMaps.end()) return &cached->second;
+
+    loadVenueLayouts();
+    auto layout = venueLayouts.find(event.getVenue());
+    if (layout == venueLayouts.end()) return nullptr;
+    if (tombstones.count(event.getEventName()) > 0) purgeOrphans();    // Seats of a deleted namesake
+
+    SeatMap map(layout->second.rows, layout->second.seatsPerRow);
+    int row = 0, seat = 0;
+    for (size_t i = 0; i < registrations.size(); i = i + 1) {
+        if (registrations[i].getEventName() == event.getEventName() &&
+            parseSeat(registrations[i].getSeat(), row, seat)) {
+            map.take(row, seat);
+        }
+    }
+    return &seatMaps.emplace(event.getEventName(), map).first->second;
+}
+
+// Pick and take seats for 'count' new registrations (empty labels where none is free,
+// or for every one if the venue has no numbered seats)
+vector<string> EventStore::assignSeats(const Event& event, size_t count) {
+    vector<string> seats(count);
+    SeatMap* map = seatMapFor(event);
+    if (map == nullptr || count == 0) return seats;
+
+    int row = 0, first = 0;
+    if (count > 1 && count <= static_cast<size_t>(map->getSeatsPerRow()) &&
+        map->findBest(static_cast<int>(count), row, first)) {
+        for (size_t k = 0; k < count; k = k + 1) {
+            map->take(row, first + static_cast<int>(k));
+            seats[k] = formatSeat(row, first + static_cast<int>(k));
+        }
+        return seats;
+    }
+    for (size_t k = 0; k < count && map->findBest(1, row, first); k = k + 1) {
+        map->take(row, first);
+        seats[k] = formatSeat(row, first);
+    }
+    return seats;
+}
+
+bool EventStore::getSeatMap(const string& eventName, SeatMap& map) {
+    ensureLoaded();
+    purgeOrphans();
+    Event* event = findLoadedEvent(eventName);
+    SeatMap* seats = (event != nullptr) ? seatMapFor(*event) : nullptr;
+    if (seats == nullptr) return false;
+    map = *seats;
+    return true;
+}
+
+// Keep the venue interval trees in step with one event (nothing to do before they are built)
+void EventStore::scheduleEvent(const Event& event) {
+    long long start = 0, end = 0;
+    if (!venueSchedulesBuilt || !eventInterval(event, start, end)) return;
+    venueSchedules[venueKey(event.getVenue())].insert(start, end, event.getEventName());
+}
+
+void EventStore::unscheduleEvent(const Event& event) {
+    long long start = 0, end = 0;
+    if (!venueSchedulesBuilt || !eventInterval(event, start, end)) return;
+    auto schedule = venueSchedules.find(venueKey(event.getVenue()));
+    if (schedule != venueSchedules.end()) schedule->second.erase(start, end, event.getEventName());
+}
+
+// Double-booking check for a new or edited event
+// What it does: The venue's interval tree (built from the table the first time) gives the
+// names of the events overlapping the candidate's time slot; only those rows are copied.
+vector<Event> EventStore::findVenueConflicts(const Event& candidate, const string& replacing) {
+    ensureLoaded();
+    if (!venueSchedulesBuilt) {
+        venueSchedulesBuilt = true;
+        for (size_t i = 0; i < events.size(); i = i + 1) {
+            scheduleEvent(events[i]);
+        }
+    }
+
+    vector<Event> conflicts;
+    long long start = 0, end = 0;
+    if (!eventInterval(candidate, start, end)) return conflicts;
+    auto schedule = venueSchedules.find(venueKey(candidate.getVenue()));
+    if (schedule == venueSchedules.end()) return conflicts;
+
+    vector<string> names;
+    schedule->second.overlapping(start, end, names);
+    for (size_t i = 0; i < names.size(); i = i + 1) {
+        Event* event = findLoadedEvent(names[i]);
+        if (names[i] != replacing && event != nullptr) conflicts.push_back(*event);
+    }
+    return conflicts;
+}
+
+// One student's timetable, built from their own registration rows the first time it is needed
+IntervalTree& EventStore::studentSchedule(const string& username) {
+    auto cached = studentSchedules.find(username);
+    if (cached != studentSchedules.end()) return cached->second;
+
+    IntervalTree& schedule = studentSchedules[username];
+    auto mine = registrationsByStudent.find(username);
+    if (mine == registrationsByStudent.end()) return schedule;
+    long long start = 0, end = 0;
+    for (size_t row : mine->second) {
+        Event* event = findLoadedEvent(registrations[row].getEventName());
+        if (event != nullptr && eventInterval(*event, start, end)) {
+            schedule.insert(start, end, event->getEventName());
+        }
+    }
+    return schedule;
+}
+
+// Keep a built timetable in step with one registration being added or removed
+void EventStore::scheduleRegistration(const Registration& registration, bool add) {
+    auto schedule = studentSchedules.find(registration.getStudentUsername());
+    if (schedule == studentSchedules.end()) return;
+    Event* event = findLoadedEvent(registration.getEventName());
+    long long start = 0, end = 0;
+    if (event == nullptr || !eventInterval(*event, start, end)) return;
+    if (add) schedule->second.insert(start, end, event->getEventName());
+    else schedule->second.erase(start, end, event->getEventName());
+}
+
+bool EventStore::findScheduleClash(const string& username, const Event& event, Event& clash) {
+    ensureLoaded();
+    long long start = 0, end = 0;
+    if (!eventInterval(event, start, end)) return false;
+    string name;
+    if (!studentSchedule(username).firstOverlapping(start, end, name)) return false;
+    Event* found = findLoadedEvent(name);
+    if (found == nullptr) return false;
+    clash = *found;
+    return true;
+}
+
+// Dense student ids: the next free number the first time a username is seen
+uint32_t EventStore::studentId(const string& username) {
+    auto found = studentIds.find(username);
+    if (found != studentIds.end()) return found->second;
+    uint32_t id = static_cast<uint32_t>(studentNames.size());
+    studentIds.emplace(username, id);
+    studentNames.push_back(username);
+    return id;
+}
+
+string EventStore::studentName(uint32_t id) const {
+    return id < studentNames.size() ? studentNames[id] : "";
+}
+
+// The set of students registered for one event
+// What it does: The first call builds every event's bitmap in one pass over the table
+// (after dropping rows of deleted events); later calls just copy one bitmap.
+RoaringBitmap EventStore::studentsOf(const string& eventName) {
+    ensureLoaded();
+    if (!eventStudentsBuilt) {
+        purgeOrphans();
+        eventStudents.clear();
+        for (size_t i = 0; i < registrations.size(); i = i + 1) {
+            eventStudents[registrations[i].getEventName()].add(studentId(registrations[i].getStudentUsername()));
+        }
+        eventStudentsBuilt = true;
+    }
+    auto members = eventStudents.find(eventName);
+    return members == eventStudents.end() ? RoaringBitmap() : members->second;
+}
+
+// The events of a student's registrations other than row 'exceptRow'
+vector<string> EventStore::otherEventsOf(const string& username, size_t exceptRow) const {
+    vector<string> names;
+    auto mine = registrationsByStudent.find(username);
+    if (mine == registrationsByStudent.end()) return names;
+    for (size_t row : mine->second) {
+        if (row != exceptRow) names.push_back(registrations[row].getEventName());
+    }
+    return names;
+}
+
+// Recommendations for one student
+// What it does: The first call counts every pair of events each student shares (one pass
+// over the per-student index); after that the counts only change with registrations.
+// The student's own events are the seeds; their rows are summed and the top n kept.
+vector<RelatedEvent> EventStore::recommendEvents(const string& username, size_t n) {
+    OperationScope scope("EventStore::recommendEvents");
+    ensureLoaded();
+    purgeOrphans();
+    if (!coRegistrationsBuilt) {
+        coRegistrations.clear();
+        for (auto& student : registrationsByStudent) {
+            vector<string> earlier;
+            for (size_t row : student.second) {
+                coRegistrations.addRegistration(registrations[row].getEventName(), earlier);
+                earlier.push_back(registrations[row].getEventName());
+            }
+        }
+        coRegistrationsBuilt = true;
+    }
+
+    vector<string> mine = otherEventsOf(username, registrations.size());
+    return coRegistrations.related(mine, n, [this](const string& name) {
+        Event* event = findLoadedEvent(name);
+        return event != nullptr && event->hasAvailableSeats();
+    });
+}
+
+// The sell-out forecast
+// What it does: The first call drops every registration date into its event's ring of
+// per-minute buckets (only the last hour survives, whatever the history holds); after that
+// addRegistration() keeps the rings current. Each event then costs one pass over 60 buckets.
+vector<EventVelocity> EventStore::registrationVelocity(long long nowMinute) {
+    OperationScope scope("EventStore::registrationVelocity");
+    ensureLoaded();
+    purgeOrphans();
+    if (!registrationRatesBuilt) {
+        registrationRates.clear();
+        long long minute = 0;
+        for (size_t i = 0; i < registrations.size(); i = i + 1) {
+            if (!parseRegistrationTime(registrations[i].getRegistrationDate(), minute)) continue;
+            if (minute <= nowMinute - RateWindow::MINUTES) continue;
+            registrationRates[registrations[i].getEventName()].record(minute);
+        }
+        registrationRatesBuilt = true;
+    }
+
+    vector<EventVelocity> report;
+    for (size_t i = 0; i < events.size(); i = i + 1) {
+        auto rate = registrationRates.find(events[i].getEventName());
+        if (rate == registrationRates.end()) continue;
+        EventVelocity velocity;
+        velocity.lastHour = rate->second.countSince(nowMinute, RateWindow::MINUTES);
+        if (velocity.lastHour == 0) continue;
+        velocity.eventName = events[i].getEventName();
+        velocity.lastQuarterHour = rate->second.countSince(nowMinute, 15);
+        velocity.seatsLeft = events[i].getAvailableSeats();    // Held seats aren't left to register into
+        velocity.minutesToFull = velocity.seatsLeft * 60.0 / velocity.lastHour;
+        report.push_back(velocity);
+    }
+    sort(report.begin(), report.end(), [](const EventVelocity& a, const EventVelocity& b) {
+        if (a.minutesToFull != b.minutesToFull) return a.minutesToFull < b.minutesToFull;
+        return a.eventName < b.eventName;
+    });
+    return report;
+}
+
+// Put a student on a full event's waitlist
+// Decided once other sessions' records are applied (commitChecked()): returns false
+// ('problem' says why) if the event is gone, has a free seat by now, or the student is
+// already registered for it or waiting for it
+bool EventStore::joinWaitlist(const string& username, size_t eventIndex, const string& joinDate, int priority,
+                              string* problem) {
+    ensureLoaded();
+    if (eventIndex >= events.size()) return false;
+
+    WaitlistEntry entry;
+    entry.username = username;
+    entry.eventName = events[eventIndex].getEventName();
+    entry.joinDate = joinDate;
+    entry.priority = priority;
+    string refusal;
+    bool saved = commitChecked([&](vector<string>& records) {
+        const Event* event = findLoadedEvent(entry.eventName);
+        if (event == nullptr) {
+            refusal = "The event no longer exists";
+        } else if (findRegistration(username, entry.eventName) != registrations.size()) {
+            refusal = "You are already registered for this event";
+        } else if (event->hasAvailableSeats()) {
+            refusal = "A seat has just become free - register for it instead";
+        } else {
+            entry.sequence = waitlist.nextSequence();
+            if (waitlist.join(entry)) {
+                records.push_back("W|" + username + "|" + entry.eventName + "|" + joinDate + "|" +
+                                  to_string(priority) + "|" + to_string(entry.sequence));
+                return true;
+            }
+            refusal = "You are already on the waitlist for this event";
+        }
+        return false;
+    });
+    if (problem != nullptr) *problem = refusal;
+    return saved;
+}
+
+// Take a student off a waitlist
+// False if they aren't on it once other sessions' records are applied (e.g. just promoted)
+bool EventStore::leaveWaitlist(const string& username, const string& eventName) {
+    ensureLoaded();
+    return commitChecked([&](vector<string>& records) {
+        if (!waitlist.leave(username, eventName)) return false;
+        records.push_back("L|" + username + "|" + eventName);
+        return true;
+    });
+}
+
+// Fill free seats of an event from its waitlist
+// What it does: Pops the next student (O(log n) each) while seats are free and turns them
+// into a normal registration. Each promotion adds an L and an R record to 'records';
+// the caller journals them with the rest of the change. A student who is registered
+// already (e.g. from a waitlist entry older than the registration) only gets the L record.
+// Returns: how many students were promoted
+size_t EventStore::promoteFromWaitlist(Event& event, vector<WaitlistEntry>* promoted, vector<string>& records) {
+    size_t count = 0;
+    WaitlistEntry next;
+    while (event.hasAvailableSeats() && waitlist.popNext(event.getEventName(), next)) {
+        if (findRegistration(next.username, next.eventName) != registrations.size()) {
+            records.push_back("L|" + next.username + "|" + next.eventName);
+            continue;
+        }
+        stats.removeEvent(event);
+        event.registerStudent();
+        stats.addEvent(event);
+        dirtyCounters.insert(static_cast<size_t>(&event - events.data()));
+        addRegistration(Registration(next.username, next.eventName, currentDateTime(), assignSeats(event, 1)[0]));
+        records.push_back("L|" + next.username + "|" + next.eventName);
+        records.push_back("R|" + registrations.back().toFileFormat());
+        if (promoted != nullptr) promoted->push_back(next);
+        count = count + 1;
+    }
+    return count;
+}
+
+// Save one change by appending its records to the journal
+// If the journal can't be written, the last saved state is loaded again,
+// so memory never shows a change that isn't on disk
+bool EventStore::commit(const vector<string>& records) {
+    OperationScope scope("EventStore::commit");
+    changeVersion = changeVersion + 1;
+    if (!journal.append(records)) {
+        cout << "Error: Could not save the change - reloading the saved data!" << endl;
+        reload();
+        return false;
+    }
+    checkpointIfJournalLarge();
+    return true;
+}
+
+// Save a change that must be checked against what other sessions did
+// What it does: Locks the journal, applies every record other sessions appended since the
+// last look, and only then runs 'decide', which checks the change against the now current
+// tables, makes it in memory and lists its records (false: refused, nothing is written).
+// The records are appended before the lock is released, so two sessions can't both take
+// the last seat: whoever comes second decides after the first one's records.
+// If another session checkpointed records this one never saw, the store is reloaded and
+// 'decide' runs again. A failed write reloads the saved state, like commit().
+bool EventStore::commitChecked(const function<bool(vector<string>& records)>& decide) {
+    OperationScope scope("EventStore::commitChecked");
+    while (true) {
+        bool accepted = false;
+        bool missed = false;
+        bool written = journal.appendChecked([this, &decide, &accepted](const vector<JournalRecord>& caughtUp,
+                                                                         vector<string>& records) {
+            for (size_t i = 0; i < caughtUp.size(); i = i + 1) {
+                vector<string> f;
+                long long first = 0, second = 0;
+                if (parseRecord(caughtUp[i], f, first, second)) applyRecord(f, first, second);
+            }
+            accepted = decide(records);
+            if (!accepted) records.clear();
+        }, missed);
+        if (missed) {
+            cout << "Note: Data was checkpointed by another session - reloading." << endl;
+            reload();
+            continue;
+        }
+
+        changeVersion = changeVersion + 1;
+        if (!written) {
+            cout << "Error: Could not save the change - reloading the saved data!" << endl;
+            reload();
+            return false;
+        }
+        checkpointIfJournalLarge();
+        return accepted;
+    }
+}
+
+// Start a background checkpoint once replaying the journal would cost about as much
+// as reading half of the data files
+void EventStore::checkpointIfJournalLarge() {
+    size_t threshold = max(CHECKPOINT_MIN_RECORDS, (events.size() + registrations.size()) / 2);
+    if (journal.recordCount() >= threshold) checkpoint(false);
+}
+
+// Fold the journal into fresh data files
+// What it does: Copies the tables (the only part that holds up the caller), then a pool
+// thread formats events.txt and registrations.txt, replaces both as one unit (temp files,
+// fsync, commit marker, rename - see durable_file.cpp) and finally trims the journal up to
+// the copied sequence number. Records journaled meanwhile stay for the next checkpoint.
+// If events.txt is fixed-width and no row was added or removed since it was written,
+// only the changed rows / seat counts and the header are overwritten in place (pwrite).
+// A crash at any step leaves old or new files plus a journal that still covers the difference.
+// If another session committed files at least as new meanwhile, nothing is written.
+bool EventStore::checkpoint(bool waitForCompletion) {
+    ensureLoaded();
+    if (runningCheckpoint.valid()) {
+        if (!waitForCompletion &&
+            runningCheckpoint.wait_for(chrono::seconds(0)) != future_status::ready) {
+            return false;    // One is already running
+        }
+        finishCheckpoint();
+    }
+    OperationScope scope("EventStore::checkpoint");
+    // Every record up to 'sequence' leaves the journal, so other sessions' records must be in the tables
+    refresh();
+    applyNewRecords();
+    purgeOrphans();
+
+    long long sequence = journal.lastSequence();
+    lastCheckpointSequence = sequence;
+
+    // Try the in-place update of events.txt first
+    vector<FilePatch> patches;
+    bool patchEvents = fixedWidthEvents && eventsFilePatchable;
+    for (size_t index : dirtyRows) {
+        if (!patchEvents) break;
+        if (!fitsFixedWidth(events[index])) patchEvents = false;
+        else patches.push_back(FilePatch{ EVENTS_FILE, static_cast<long long>(FIXED_HEADER_LENGTH + index * FIXED_ROW_LENGTH),
+                                          fixedRow(events[index]) });
+    }
+    for (size_t index : dirtyCounters) {
+        if (!patchEvents) break;
+        if (dirtyRows.count(index) > 0) continue;
+        string count = to_string(events[index].getRegisteredCount());
+        if (count.size() > NUMBER_WIDTH) patchEvents = false;
+        else patches.push_back(FilePatch{ EVENTS_FILE,
+                                          static_cast<long long>(FIXED_HEADER_LENGTH + index * FIXED_ROW_LENGTH + REGISTERED_OFFSET),
+                                          padNumber(events[index].getRegisteredCount(), NUMBER_WIDTH) });
+    }
+    // The index only needs its new sequence unless an edit may have renamed a row
+    // (rows never move in the fixed-width file, so their offsets are known without formatting)
+    auto indexEntries = make_shared<vector<EventOffset>>();
+    bool rewriteIndex = true;
+    struct stat indexInfo;
+    if (patchEvents) {
+        patches.push_back(FilePatch{ EVENTS_FILE, 0, fixedHeader(sequence) });
+        if (dirtyRows.empty() && stat(EVENTS_INDEX_FILE, &indexInfo) == 0) {
+            patches.push_back(FilePatch{ EVENTS_INDEX_FILE, 0, eventIndexHeader(sequence) });
+            rewriteIndex = false;
+        } else {
+            for (size_t i = 0; i < events.size(); i = i + 1) {
+                indexEntries->push_back(EventOffset{ events[i].getEventName(),
+                                                     static_cast<long long>(FIXED_HEADER_LENGTH + i * FIXED_ROW_LENGTH) });
+            }
+        }
+    } else {
+        patches.clear();
+    }
+
+    // Otherwise rewrite it (fixed-width if asked for and every event fits)
+    bool writeFixed = false;
+    if (!patchEvents && fixedWidthEvents) {
+        writeFixed = true;
+        for (size_t i = 0; i < events.size() && writeFixed; i = i + 1) {
+            writeFixed = fitsFixedWidth(events[i]);
+        }
+    }
+    dirtyRows.clear();
+    dirtyCounters.clear();
+    eventsFilePatchable = patchEvents || writeFixed;
+
+    auto eventsCopy = make_shared<vector<Event>>(patchEvents ? vector<Event>() : events);
+    auto registrationsCopy = make_shared<vector<Registration>>(registrations);
+    auto waitingCopy = make_shared<vector<WaitlistEntry>>(waitlist.allEntries());
+    auto holdsCopy = make_shared<vector<HoldEntry>>();
+    for (auto& hold : holds) {
+        holdsCopy->push_back(HoldEntry{ hold.second.username, hold.second.eventName, hold.second.holdDate,
+                                        hold.second.expiresAt });
+    }
+    auto done = make_shared<promise<bool>>();
+    runningCheckpoint = done->get_future();
+    auto superseded = make_shared<bool>(false);    // Read by finishCheckpoint once 'done' is set
+    checkpointSuperseded = superseded;
+    long long plannedEvents = eventsFileSequence;    // The files this checkpoint was planned against
+    long long plannedRegistrations = registrationsFileSequence;
+
+    Journal* log = &journal;
+    ThreadPool::instance().submit([eventsCopy, registrationsCopy, waitingCopy, holdsCopy, done, superseded, log,
+                                   sequence, plannedEvents, plannedRegistrations, indexEntries, rewriteIndex,
+                                   patches, patchEvents, writeFixed]() {
+        OperationScope scope("EventStore::checkpointWrite");    // Runs after the caller's scope has ended
+        vector<pair<string, string>> files;
+        if (!patchEvents) {
+            files.push_back(make_pair(string(EVENTS_FILE), formatEventsFile(*eventsCopy, sequence, writeFixed, *indexEntries)));
+        }
+        if (rewriteIndex) {
+            files.push_back(make_pair(string(EVENTS_INDEX_FILE), formatEventIndex(*indexEntries, sequence)));
+        }
+        files.push_back(make_pair(string(REGISTRATIONS_FILE),
+                                  formatRegistrationsFile(*registrationsCopy, *waitingCopy, *holdsCopy, sequence)));
+        bool ok = false;
+        {
+            ExclusiveFileLock lock(CHECKPOINT_LOCK);    // One commit at a time, never during a recovery
+            // Another session may have committed since this checkpoint was planned. Files that
+            // already hold every record up to 'sequence' are never replaced by these older ones,
+            // and rows are never patched in a file this session didn't plan the patches for.
+            // (Files that were already at 'sequence' when it was planned are still rewritten:
+            // nothing new was journaled, but the layout may change or a table was replaced.)
+            // Without the lock nothing is written: the journal still holds every record.
+            long long eventsOnDisk = fileSequence(EVENTS_FILE);
+            long long registrationsOnDisk = fileSequence(REGISTRATIONS_FILE);
+            bool eventsNewer = eventsOnDisk > sequence || (eventsOnDisk == sequence && eventsOnDisk != plannedEvents);
+            bool registrationsNewer = registrationsOnDisk > sequence ||
+                                      (registrationsOnDisk == sequence && registrationsOnDisk != plannedRegistrations);
+            if (!lock.held()) {
+                ok = false;
+            } else if (eventsNewer || registrationsNewer) {
+                *superseded = true;
+                ok = true;
+            } else if (patchEvents && eventsOnDisk != plannedEvents) {
+                ok = false;
+            } else {
+                ok = commitFilesAtomically(files, patches, COMMIT_MARKER) && log->dropThrough(sequence);
+            }
+        }
+        done->set_value(ok);
+    });
+
+    if (waitForCompletion) return finishCheckpoint();
+    return true;
+}
+
+bool EventStore::finishCheckpoint() {
+    if (!runningCheckpoint.valid()) return true;
+    bool ok = runningCheckpoint.get();
+    if (!ok || *checkpointSuperseded) {
+        eventsFilePatchable = false;    // Don't trust the file layout after a failed or skipped write
+    } else {
+        eventsFileSequence = lastCheckpointSequence;    // The files are now the ones this session wrote
+        registrationsFileSequence = lastCheckpointSequence;
+    }
+    return ok;
+}
+
+void EventStore::setFixedWidthEvents(bool enabled) {
+    if (enabled && !fixedWidthEvents) eventsFilePatchable = false;    // Convert at the next checkpoint
+    fixedWidthEvents = enabled;
+}
+
+size_t EventStore::journalRecords() const {
+    return journal.recordCount();
+}
+
+// Throw away cached data; the next read loads the files again
+void EventStore::reload() {
+    finishCheckpoint();
+    eventsLoaded = false;
+    registrationsLoaded = false;
+    venuesLoaded = false;
+    journalErrorsReported = false;
+    ensureLoaded();
+}
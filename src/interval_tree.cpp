@@ -0,0 +1,166 @@
+#include "interval_tree.h"
+
+// ========================================
+// INTERVAL_TREE.CPP - Augmented Treap of Intervals
+// ========================================
+// This file implements the interval index behind venue double-booking checks and
+// student timetable clash checks.
+// Insert and erase split the tree at the interval's key and merge the pieces back;
+// every node on the way gets its subtree's largest end recomputed.
+// Demonstrates: Treaps (split/merge), augmented search trees, pruned traversal
+
+IntervalTree::IntervalTree() : root(-1), count(0), seed(2463534242u) {}
+
+// Tree order: start, then end, then id (so equal starts still have one place each)
+bool IntervalTree::lessThan(const Node& node, long long start, long long end, const string& id) const {
+    if (node.start != start) return node.start < start;
+    if (node.end != end) return node.end < end;
+    return node.id < id;
+}
+
+void IntervalTree::update(int node) {
+    Node& n = nodes[node];
+    n.maxEnd = n.end;
+    if (n.left >= 0 && nodes[n.left].maxEnd > n.maxEnd) n.maxEnd = nodes[n.left].maxEnd;
+    if (n.right >= 0 && nodes[n.right].maxEnd > n.maxEnd) n.maxEnd = nodes[n.right].maxEnd;
+}
+
+// Cut a subtree in two: intervals ordered before the key go left, the rest go right
+void IntervalTree::split(int node, long long start, long long end, const string& id, int& left, int& right) {
+    if (node < 0) {
+        left = -1;
+        right = -1;
+        return;
+    }
+    if (lessThan(nodes[node], start, end, id)) {
+        int rest;
+        split(nodes[node].right, start, end, id, rest, right);
+        nodes[node].right = rest;
+        left = node;
+    } else {
+        int rest;
+        split(nodes[node].left, start, end, id, left, rest);
+        nodes[node].left = rest;
+        right = node;
+    }
+    update(node);
+}
+
+// Join two subtrees where everything in 'left' comes before everything in 'right'
+int IntervalTree::merge(int left, int right) {
+    if (left < 0) return right;
+    if (right < 0) return left;
+    if (nodes[left].priority > nodes[right].priority) {
+        nodes[left].right = merge(nodes[left].right, right);
+        update(left);
+        return left;
+    }
+    nodes[right].left = merge(left, nodes[right].left);
+    update(right);
+    return right;
+}
+
+void IntervalTree::insert(long long start, long long end, const string& id) {
+    int node;
+    if (!freeNodes.empty()) {
+        node = freeNodes.back();
+        freeNodes.pop_back();
+    } else {
+        node = static_cast<int>(nodes.size());
+        nodes.push_back(Node());
+    }
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    Node& n = nodes[node];
+    n.start = start;
+    n.end = end;
+    n.maxEnd = end;
+    n.id = id;
+    n.priority = seed;
+    n.left = -1;
+    n.right = -1;
+
+    int left, right;
+    split(root, start, end, id, left, right);
+    root = merge(merge(left, node), right);
+    count = count + 1;
+}
+
+int IntervalTree::eraseFrom(int node, long long start, long long end, const string& id, bool& erased) {
+    if (node < 0) return -1;
+    Node& n = nodes[node];
+    if (n.start == start && n.end == end && n.id == id) {
+        int replacement = merge(n.left, n.right);
+        n.id.clear();
+        freeNodes.push_back(node);
+        erased = true;
+        return replacement;
+    }
+    if (lessThan(n, start, end, id)) {
+        int child = eraseFrom(n.right, start, end, id, erased);
+        nodes[node].right = child;
+    } else {
+        int child = eraseFrom(n.left, start, end, id, erased);
+        nodes[node].left = child;
+    }
+    update(node);
+    return node;
+}
+
+bool IntervalTree::erase(long long start, long long end, const string& id) {
+    bool erased = false;
+    root = eraseFrom(root, start, end, id, erased);
+    if (erased) count = count - 1;
+    return erased;
+}
+
+// Walk only the parts of the tree that can hold an overlap
+// What it does: A subtree whose largest end is at or before 'start' holds nothing that
+// reaches the query; once a node starts at or after 'end', so does its whole right subtree.
+void IntervalTree::collect(int node, long long start, long long end, vector<string>& ids) const {
+    if (node < 0 || nodes[node].maxEnd <= start) return;
+    const Node& n = nodes[node];
+    collect(n.left, start, end, ids);
+    if (n.start >= end) return;
+    if (n.end > start) ids.push_back(n.id);
+    collect(n.right, start, end, ids);
+}
+
+void IntervalTree::overlapping(long long start, long long end, vector<string>& ids) const {
+    collect(root, start, end, ids);
+}
+
+// Find the earliest overlap without listing the others
+// What it does: If the left subtree reaches past 'start' the answer can only be there: any
+// interval in it that doesn't overlap starts at or after 'end', and so does everything after it.
+// Otherwise the node itself is checked, and then only the right subtree can hold one.
+bool IntervalTree::firstOverlapping(long long start, long long end, string& id) const {
+    int node = root;
+    while (node >= 0) {
+        const Node& n = nodes[node];
+        if (n.left >= 0 && nodes[n.left].maxEnd > start) {
+            node = n.left;
+        } else if (n.start >= end) {
+            return false;
+        } else if (n.end > start) {
+            id = n.id;
+            return true;
+        } else {
+            node = n.right;
+        }
+    }
+    return false;
+}
+
+size_t IntervalTree::size() const {
+    return count;
+}
+
+void IntervalTree::clear() {
+    nodes.clear();
+    freeNodes.clear();
+    root = -1;
+    count = 0;
+}
@@ -0,0 +1,336 @@
+#include "journal.h"
+#include "durable_file.h"
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <cerrno>
+#include <thread>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ========================================
+// JOURNAL.CPP - Append-Only Change Log
+// ========================================
+// This file keeps data/journal.txt, a small log that changes are appended to
+// instead of rewriting the big data files every time.
+// The data files plus the journal records newer than each file always describe the current state.
+// Several sessions can share the journal: appends and trims take an flock on the file, and
+// each session reads only the bytes others added since it last looked.
+// Demonstrates: Write-ahead logging, fsync with group commit, condition variables, atomic rename, flock
+
+// First line of a trimmed journal: "#trimmed|<sequence>" - every record up to that number
+// is in the data files now (lets other sessions number after it and notice what they missed)
+static const string TRIMMED_HEADER = "#trimmed|";
+
+// Split "sequence|rest" (returns 0 if the line doesn't start with a sequence number)
+static long long parseSequence(const string& line, string* rest) {
+    size_t bar = line.find('|');
+    if (bar == string::npos || bar == 0 || bar >= 19 || line.find_first_not_of("0123456789") != bar) {
+        return 0;
+    }
+    if (rest != nullptr) *rest = line.substr(bar + 1);
+    return stoll(line.substr(0, bar));
+}
+
+Journal::Journal(const string& filePath)
+    : path(filePath), fd(-1), records(0), last(0), durable(0), syncing(false),
+      groupWindow(0), syncs(0), readInode(0), readOffset(0), missedSinceRead(false) {}
+
+Journal::~Journal() {
+    if (fd >= 0) close(fd);
+}
+
+// Open journal.txt for appending (kept open so every append doesn't pay for open/close)
+bool Journal::openForAppend() {
+    if (fd >= 0) return true;
+    fd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        cout << "Error: Could not open " << path << " for writing!" << endl;
+        return false;
+    }
+    return true;
+}
+
+bool Journal::append(const string& record) {
+    return append(vector<string>(1, record));
+}
+
+// Number the records, write them in one go, then wait until they are durable
+// What it does: Locks the journal file against other sessions, reads whatever they appended
+// (so our numbers continue after theirs), writes, and unlocks before the fsync.
+bool Journal::append(const vector<string>& newRecords) {
+    if (newRecords.empty()) return true;
+    unique_lock<mutex> lock(fileMutex);
+    if (!lockFile(lock)) return false;
+    catchUp();
+    return writeLocked(lock, newRecords);
+}
+
+// Same as append(), but the records are only decided once the file is locked and every
+// other session's records have been read, so nobody can append in between
+bool Journal::appendChecked(const function<void(const vector<JournalRecord>&, vector<string>&)>& decide,
+                            bool& missed) {
+    missed = false;
+    unique_lock<mutex> lock(fileMutex);
+    if (!lockFile(lock)) return false;
+    catchUp();
+    if (missedSinceRead) {
+        missedSinceRead = false;
+        missed = true;
+        flock(fd, LOCK_UN);
+        return false;
+    }
+
+    vector<JournalRecord> caughtUp;
+    caughtUp.swap(unseen);
+    vector<string> newRecords;
+    decide(caughtUp, newRecords);
+    if (newRecords.empty()) {
+        flock(fd, LOCK_UN);
+        return true;
+    }
+    return writeLocked(lock, newRecords);
+}
+
+// Take the flock on the open journal (caller holds fileMutex)
+// If a checkpoint replaced the file while we waited for the lock, the new file is opened.
+bool Journal::lockFile(unique_lock<mutex>& lock) {
+    while (true) {
+        if (!openForAppend()) return false;
+        flock(fd, LOCK_EX);
+        struct stat opened, current;
+        if (fstat(fd, &opened) == 0 && stat(path.c_str(), &current) == 0 && opened.st_ino == current.st_ino) return true;
+        flock(fd, LOCK_UN);
+        synced.wait(lock, [this]() { return !syncing; });    // The leader is still using fd
+        close(fd);
+        fd = -1;
+    }
+}
+
+// Number and write the records, release the flock, then wait for the fsync
+// (caller holds fileMutex and the flock, and has caught up)
+bool Journal::writeLocked(unique_lock<mutex>& lock, const vector<string>& newRecords) {
+    string text;
+    long long sequence = last;
+    for (size_t i = 0; i < newRecords.size(); i = i + 1) {
+        sequence = sequence + 1;
+        text += to_string(sequence) + "|" + newRecords[i] + '\n';
+    }
+
+    const char* data = text.data();
+    size_t left = text.size();
+    while (left > 0) {
+        ssize_t written = write(fd, data, left);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            cout << "Error: Could not write " << path << "!" << endl;
+            flock(fd, LOCK_UN);
+            return false;
+        }
+        data = data + written;
+        left = left - static_cast<size_t>(written);
+    }
+    flock(fd, LOCK_UN);
+
+    last = sequence;
+    records = records + newRecords.size();
+    return syncThrough(lock, sequence);
+}
+
+// Group commit
+// What it does: If another thread is already fsyncing, wait for it - if our records were
+// written before its fsync started they are covered. Otherwise become the leader: optionally
+// wait a moment for more appends, then one fsync covers everything written so far.
+bool Journal::syncThrough(unique_lock<mutex>& lock, long long sequence) {
+    while (durable < sequence) {
+        if (syncing) {
+            synced.wait(lock);
+            continue;
+        }
+
+        syncing = true;
+        if (groupWindow.count() > 0) {
+            lock.unlock();
+            this_thread::sleep_for(groupWindow);
+            lock.lock();
+        }
+        long long covered = last;
+        int syncFd = fd;
+        lock.unlock();
+        bool ok = fdatasync(syncFd) == 0;
+        lock.lock();
+
+        syncing = false;
+        syncs = syncs + 1;
+        if (ok && covered > durable) durable = covered;
+        synced.notify_all();
+        if (!ok) {
+            cout << "Error: Could not sync " << path << " to disk!" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Parse journal lines (empty lines are ignored, unreadable ones get sequence 0)
+// 'trimmedThrough' is set from a "#trimmed|" header line
+static void parseRecords(istream& in, vector<JournalRecord>& result, long long* trimmedThrough = nullptr) {
+    string line;
+    while (getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        if (line[0] == '#') {
+            string rest;
+            if (trimmedThrough != nullptr && line.compare(0, TRIMMED_HEADER.size(), TRIMMED_HEADER) == 0) {
+                *trimmedThrough = parseSequence(line.substr(TRIMMED_HEADER.size()) + "|", &rest);
+            }
+            continue;
+        }
+
+        JournalRecord record{ 0, line };
+        record.sequence = parseSequence(line, &record.text);
+        result.push_back(record);
+    }
+}
+
+// Read every record
+vector<JournalRecord> Journal::readAll() const {
+    lock_guard<mutex> lock(fileMutex);
+    vector<JournalRecord> result;
+    ifstream file(path);
+    parseRecords(file, result);
+    return result;
+}
+
+// Read the bytes appended since the last look (caller holds fileMutex)
+// What it does: Parses only complete lines - a line another session is still writing is
+// picked up next time. Our own appends are in there too; they are skipped because their
+// numbers are not above 'last'. A file with a new inode (or that shrank) was replaced by a
+// checkpoint: it is read from the start, and every record in it counts as not checkpointed.
+// If its "#trimmed|" header is past 'last', records were folded into the data files before
+// this session read them.
+void Journal::catchUp() {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) return;
+
+    bool replaced = info.st_ino != readInode || info.st_size < readOffset;
+    if (replaced) {
+        readInode = info.st_ino;
+        readOffset = 0;
+        records = 0;
+    }
+    if (info.st_size == readOffset) return;
+
+    ifstream file(path, ios::binary);
+    file.seekg(readOffset);
+    string text(static_cast<size_t>(info.st_size - readOffset), '\0');
+    file.read(&text[0], static_cast<streamsize>(text.size()));
+    text.resize(static_cast<size_t>(file.gcount()));
+    size_t complete = text.rfind('\n');
+    if (complete == string::npos) return;
+    text.resize(complete + 1);
+    readOffset = readOffset + static_cast<long long>(text.size());
+
+    istringstream lines(text);
+    vector<JournalRecord> found;
+    long long trimmedThrough = 0;
+    parseRecords(lines, found, &trimmedThrough);
+    if (trimmedThrough > last) {
+        last = trimmedThrough;
+        missedSinceRead = true;
+    }
+    for (size_t i = 0; i < found.size(); i = i + 1) {
+        if (replaced) records = records + 1;
+        if (found[i].sequence <= last) continue;
+        if (!replaced) records = records + 1;
+        last = found[i].sequence;
+        unseen.push_back(found[i]);
+    }
+    if (durable < last) durable = last;    // The other session made its own records durable
+}
+
+vector<JournalRecord> Journal::readNewRecords(bool& missed) {
+    lock_guard<mutex> lock(fileMutex);
+    catchUp();
+    missed = missedSinceRead;
+    missedSinceRead = false;
+    vector<JournalRecord> result;
+    result.swap(unseen);
+    return result;
+}
+
+// Keep only the records newer than 'sequence'
+// What it does: Copies the tail to journal.txt.tmp (fsynced) and renames it over journal.txt.
+// rename() replaces the file in one step, so a crash leaves either the old or the new journal.
+bool Journal::dropThrough(long long sequence) {
+    unique_lock<mutex> lock(fileMutex);
+    synced.wait(lock, [this]() { return !syncing; });    // The leader is still using fd
+
+    // Hold the file lock until the rename, so no other session appends to the old file
+    // after its tail was copied
+    int lockFd = open(path.c_str(), O_RDONLY | O_CREAT, 0644);
+    if (lockFd >= 0) flock(lockFd, LOCK_EX);
+
+    ifstream in(path);
+    string tail = TRIMMED_HEADER + to_string(sequence) + '\n';
+    size_t kept = 0;
+    string line;
+    while (getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        if (parseSequence(line, nullptr) > sequence) {
+            tail += line + '\n';
+            kept = kept + 1;
+        }
+    }
+    in.close();
+
+    string tempPath = path + ".tmp";
+    bool ok = writeFileDurably(tempPath, tail) && rename(tempPath.c_str(), path.c_str()) == 0;
+    if (lockFd >= 0) close(lockFd);    // Also releases the lock
+    if (!ok) {
+        cout << "Error: Could not replace " << path << "!" << endl;
+        return false;
+    }
+    size_t slash = path.rfind('/');
+    syncDirectory(slash == string::npos ? "." : path.substr(0, slash));
+
+    // The old file is gone: the next append opens the new one. Everything kept is now on disk.
+    if (fd >= 0) close(fd);
+    fd = -1;
+    durable = last;
+    records = kept;
+    readOffset = 0;    // Read the new file from the start (other sessions' records are skipped by number)
+    return true;
+}
+
+size_t Journal::recordCount() const {
+    lock_guard<mutex> lock(fileMutex);
+    return records;
+}
+
+long long Journal::lastSequence() const {
+    lock_guard<mutex> lock(fileMutex);
+    return last;
+}
+
+void Journal::resetCounters(size_t count, long long sequence) {
+    lock_guard<mutex> lock(fileMutex);
+    records = count;
+    last = sequence;
+    durable = sequence;
+    unseen.clear();
+    missedSinceRead = false;
+}
+
+void Journal::setGroupCommitWindow(chrono::microseconds window) {
+    lock_guard<mutex> lock(fileMutex);
+    groupWindow = window;
+}
+
+size_t Journal::syncCount() const {
+    lock_guard<mutex> lock(fileMutex);
+    return syncs;
+}
@@ -9,9 +9,13 @@
 #include "admin.h"      // Admin class (inherits from User)
 #include "student.h"    // Student class (inherits from User)
 #include "utils.h"      // Utility functions (split, trim, etc.)
+#include "metrics.h"    // Operation metrics (only active in PROFILE=1 builds)
+#include "table_renderer.h"  // Paging options for event tables
+#include "event_store.h"  // Shared data store (pending clean-up at exit)
 #include <iostream>     // For input/output (cin, cout)
 #include <fstream>      // For file operations (ifstream, ofstream)
 #include <vector>       // For dynamic arrays (vector)
+#include <charconv>     // For from_chars (reading numbers without exceptions)
 
 using namespace std;    // Avoids writing std:: before cout, cin, string, etc.
 
@@ -98,12 +102,67 @@ void displayWelcome() {
     cout << "=================================================" << endl;
 }
 
+// ==================== COMMAND LINE OPTIONS ====================
+
+// Read a whole option value as a count (false if it isn't one or is too large)
+// from_chars never throws, so "--page 99999999999999999999" can't end the program
+static bool readCount(const string& text, size_t& value) {
+    auto result = from_chars(text.data(), text.data() + text.size(), value);
+    return !text.empty() && result.ec == errc() && result.ptr == text.data() + text.size();
+}
+
+// Read --page N and --limit N (also --page=N / --limit=N)
+// What it does: Configures paging for every event table; unknown or invalid options are reported
+// and ignored, leaving that setting at its default
+// Example: ./build/event-management --limit 50 --page 2
+void parseCommandLine(int argc, char* argv[]) {
+    size_t page = 1;
+    size_t limit = 0;
+    
+    for (int i = 1; i < argc; i = i + 1) {
+        string arg = argv[i];
+        string value;
+        string name = arg;
+        size_t number = 0;
+        
+        // Accept both "--limit 50" and "--limit=50"
+        size_t equals = arg.find('=');
+        if (equals != string::npos) {
+            name = arg.substr(0, equals);
+            value = arg.substr(equals + 1);
+        } else if ((arg == "--page" || arg == "--limit") && i + 1 < argc) {
+            i = i + 1;
+            value = argv[i];
+            arg = arg + " " + value;    // Report the pair if the value is rejected
+        }
+        
+        if (name == "--fixed-width-events" && value.empty()) {
+            // Store events.txt in padded columns so seat counts can be updated in place
+            EventStore::instance().setFixedWidthEvents(true);
+        } else if ((name == "--page" || name == "--limit") && readCount(value, number)) {
+            if (name == "--page") {
+                page = number;
+            } else {
+                limit = number;
+            }
+        } else {
+            cout << "Warning: ignoring unknown or invalid option '" << arg << "'" << endl;
+            cout << "Usage: event-management [--limit ROWS_PER_PAGE] [--page START_PAGE] [--fixed-width-events]" << endl;
+        }
+    }
+    
+    TableRenderer::setPaging(page, limit);
+}
+
 // ==================== MAIN APPLICATION ====================
 
 // Main function - Program execution starts here
 // What it does: Handles login, shows menus, processes user choices, and cleans up
 // Return value: 0 means success, 1 means error/failure
-int main() {
+int main(int argc, char* argv[]) {
+    // Paging options for long event lists (--page / --limit)
+    parseCommandLine(argc, argv);
+    
     // Show welcome message first
     displayWelcome();
     
@@ -171,6 +230,9 @@ int main() {
         cin >> choice;      // Get user's menu choice
         cin.ignore();       // Ignore the newline character left in the input buffer
         
+        // Pick up what other sessions changed while the menu was waiting
+        EventStore::instance().refresh();
+        
         // DYNAMIC CASTING - Handle menu choices based on actual user type
         // dynamic_cast<Admin*> tries to convert User* to Admin*
         // If currentUser is actually an Admin, it succeeds and returns the pointer
@@ -201,13 +263,21 @@ int main() {
                     admin->manageUsers();
                     break;
                 case 6:
+                    // Bulk reports and analysis (export all event reports, ...)
+                    admin->reportsMenu();
+                    break;
+                case 7:
+                    // Fold the change journal into the data files now
+                    admin->checkpointDataFiles();
+                    break;
+                case 8:
                     // Logout - exit the main loop
                     cout << "\nLogging out..." << endl;
                     cout << "Thank you for using Admin panel!" << endl;
                     running = false;    // This will exit the while loop
                     break;
                 default:
-                    cout << "Invalid choice! Please select 1-6." << endl;
+                    cout << "Invalid choice! Please select 1-8." << endl;
             }
         } 
         else if (Student* student = dynamic_cast<Student*>(currentUser)) {
@@ -253,13 +323,21 @@ int main() {
                     break;
                 }
                 case 4:
+                    // Register for several events in one transaction
+                    student->registerForMultipleEvents();
+                    break;
+                case 5:
+                    // Events that students with similar registrations chose
+                    student->viewRecommendedEvents();
+                    break;
+                case 6:
                     // Logout - exit the main loop
                     cout << "\nLogging out..." << endl;
                     cout << "Thank you for using Student portal!" << endl;
                     running = false;    // This will exit the while loop
                     break;
                 default:
-                    cout << "Invalid choice! Please select 1-4." << endl;
+                    cout << "Invalid choice! Please select 1-6." << endl;
             }
         }
     }
@@ -269,6 +347,13 @@ int main() {
     // This is CRITICAL in C++ - forgetting to delete causes memory leaks
     delete currentUser;
     
+    // Let a checkpoint that is already running finish; the journal itself is only folded
+    // once it grows large (or from the admin menu), not on every logout
+    EventStore::instance().finishCheckpoint();
+    
+    // Show per-operation latency/allocation numbers (prints nothing in a normal build)
+    printOperationMetrics(cout);
+    
     cout << "\n=== SESSION ENDED ===" << endl;
     cout << "Thank you for using College Event Management System!" << endl;
     
@@ -0,0 +1,218 @@
+#include "metrics.h"
+
+// ========================================
+// METRICS.CPP - Operation Metrics Implementation
+// ========================================
+// This file measures how long each operation takes and how much heap memory it allocates.
+// It only does something when built with "make PROFILE=1"; otherwise it compiles to nothing.
+// Demonstrates: RAII (timing a scope), operator new/delete replacement, thread_local variables, atomics
+
+#ifdef EM_PROFILE
+
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <new>
+#include <iomanip>
+
+// Totals collected for one operation name across the whole session
+struct OperationTotals {
+    size_t calls = 0;
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+    size_t allocCount = 0;
+    size_t allocBytes = 0;
+    size_t freeCount = 0;
+    size_t freeBytes = 0;
+};
+
+// Innermost active scope on the current thread (allocations are charged to it)
+static thread_local OperationScope* currentScope = nullptr;
+
+// Set while we update the metrics table, so its own allocations are not counted
+static thread_local bool suspended = false;
+
+// The metrics table is created on first use and never destroyed,
+// because operator delete may still run during static destruction
+static mutex& tableMutex() {
+    static mutex* m = new mutex();
+    return *m;
+}
+
+static map<string, OperationTotals>& table() {
+    static map<string, OperationTotals>* t = new map<string, OperationTotals>();
+    return *t;
+}
+
+// Start timing and become the current scope on this thread
+OperationScope::OperationScope(const char* opName)
+    : name(opName),
+      parent(currentScope),
+      start(chrono::steady_clock::now()),
+      allocCount(0),
+      allocBytes(0),
+      freeCount(0),
+      freeBytes(0) {
+    currentScope = this;
+}
+
+OperationScope* currentOperation() {
+    return currentScope;
+}
+
+// Borrow the submitting thread's scope for the length of one pool task
+WorkerScope::WorkerScope(OperationScope* owner) : saved(currentScope) {
+    currentScope = owner;
+}
+
+WorkerScope::~WorkerScope() {
+    currentScope = saved;
+}
+
+// Stop timing, fold our numbers into the parent scope and the global table
+// Accounting is inclusive: a parent's numbers include everything its children allocated
+OperationScope::~OperationScope() {
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    currentScope = parent;
+
+    if (parent != nullptr) {
+        parent->allocCount += allocCount;
+        parent->allocBytes += allocBytes;
+        parent->freeCount += freeCount;
+        parent->freeBytes += freeBytes;
+    }
+
+    suspended = true;
+    {
+        lock_guard<mutex> lock(tableMutex());
+        OperationTotals& totals = table()[name];
+        totals.calls = totals.calls + 1;
+        totals.totalMs = totals.totalMs + ms;
+        if (ms > totals.maxMs) totals.maxMs = ms;
+        totals.allocCount = totals.allocCount + allocCount;
+        totals.allocBytes = totals.allocBytes + allocBytes;
+        totals.freeCount = totals.freeCount + freeCount;
+        totals.freeBytes = totals.freeBytes + freeBytes;
+    }
+    suspended = false;
+}
+
+// Charge one allocation to the innermost active scope (if any)
+void OperationScope::recordAllocation(size_t bytes) {
+    if (suspended || currentScope == nullptr) return;
+    currentScope->allocCount += 1;
+    currentScope->allocBytes += bytes;
+}
+
+// Charge one deallocation; bytes is 0 when the compiler did not use sized delete
+void OperationScope::recordDeallocation(size_t bytes) {
+    if (suspended || currentScope == nullptr) return;
+    currentScope->freeCount += 1;
+    currentScope->freeBytes += bytes;
+}
+
+// Print one row per operation: calls, latency, and allocations per call
+void printOperationMetrics(ostream& out) {
+    suspended = true;
+    lock_guard<mutex> lock(tableMutex());
+
+    out << "\n=== OPERATION METRICS ===" << "\n";
+    if (table().empty()) {
+        out << "No operations recorded." << "\n";
+        suspended = false;
+        return;
+    }
+
+    out << left << setw(36) << "OPERATION"
+        << right << setw(7) << "CALLS"
+        << setw(11) << "AVG ms"
+        << setw(11) << "MAX ms"
+        << setw(12) << "ALLOCS/op"
+        << setw(14) << "BYTES/op"
+        << setw(12) << "FREES/op" << "\n";
+    out << string(103, '-') << "\n";
+
+    for (const auto& entry : table()) {
+        const OperationTotals& t = entry.second;
+        double calls = static_cast<double>(t.calls);
+        out << left << setw(36) << entry.first
+            << right << setw(7) << t.calls
+            << fixed << setprecision(3)
+            << setw(11) << t.totalMs / calls
+            << setw(11) << t.maxMs
+            << setprecision(1)
+            << setw(12) << t.allocCount / calls
+            << setw(14) << t.allocBytes / calls
+            << setw(12) << t.freeCount / calls << "\n";
+    }
+    out << flush;
+    suspended = false;
+}
+
+// ==================== GLOBAL ALLOCATION HOOKS ====================
+// Replacing the global operator new/delete lets us see every heap allocation in the program,
+// including the ones made inside std::string and std::vector.
+
+void* operator new(size_t size) {
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == nullptr) throw bad_alloc();
+    OperationScope::recordAllocation(size);
+    return p;
+}
+
+void* operator new[](size_t size) {
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == nullptr) throw bad_alloc();
+    OperationScope::recordAllocation(size);
+    return p;
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p != nullptr) OperationScope::recordAllocation(size);
+    return p;
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p != nullptr) OperationScope::recordAllocation(size);
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    if (p == nullptr) return;
+    OperationScope::recordDeallocation(0);
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    if (p == nullptr) return;
+    OperationScope::recordDeallocation(0);
+    free(p);
+}
+
+void operator delete(void* p, size_t size) noexcept {
+    if (p == nullptr) return;
+    OperationScope::recordDeallocation(size);
+    free(p);
+}
+
+void operator delete[](void* p, size_t size) noexcept {
+    if (p == nullptr) return;
+    OperationScope::recordDeallocation(size);
+    free(p);
+}
+
+void operator delete(void* p, const nothrow_t&) noexcept {
+    if (p == nullptr) return;
+    OperationScope::recordDeallocation(0);
+    free(p);
+}
+
+void operator delete[](void* p, const nothrow_t&) noexcept {
+    if (p == nullptr) return;
+    OperationScope::recordDeallocation(0);
+    free(p);
+}
+
+#endif // EM_PROFILE
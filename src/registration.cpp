@@ -8,12 +8,14 @@
 
 // Constructor with member initializer list
 // What it does: Creates a Registration object linking a student to an event
-// Parameters: username (student's username), event (event name), regDate (registration timestamp)
+// Parameters: username (student's username), event (event name), regDate (registration timestamp),
+// seatLabel (assigned seat such as "3-14", empty if the venue has no numbered seats)
 // The colon syntax (:) is called a "member initializer list" - it's more efficient than assigning in the body
-Registration::Registration(string username, string event, string regDate)
+Registration::Registration(string username, string event, string regDate, string seatLabel)
     : studentUsername(username),      // Initialize studentUsername member
       eventName(event),                // Initialize eventName member
-      registrationDate(regDate) {}     // Initialize registrationDate member
+      registrationDate(regDate),       // Initialize registrationDate member
+      seat(seatLabel) {}               // Initialize seat member
 
 // Getter methods - Allow read-only access to private member variables
 // 'const' at the end means these functions don't modify the object
@@ -29,13 +31,23 @@ string Registration::getRegistrationDate() const {
     return registrationDate;   // Return when they registered
 }
 
+string Registration::getSeat() const {
+    return seat;               // Return the assigned seat (empty if none)
+}
+
+void Registration::setEventName(const string& name) {
+    eventName = name;
+}
+
 // Format registration data for file storage
 // What it does: Converts the registration object into a string for saving to registrations.txt
-// Format: username|eventname|date
-// Example: "john|Tech Fest 2025|15-03-2025 14:30"
+// Format: username|eventname|date, plus |seat when a seat was assigned
+// Example: "john|Tech Fest 2025|15-03-2025 14:30|3-14"
 // Why pipe (|): We use | as a separator because event names might contain commas
 string Registration::toFileFormat() const {
-    return studentUsername + "|" + eventName + "|" + registrationDate;
+    string line = studentUsername + "|" + eventName + "|" + registrationDate;
+    if (!seat.empty()) line += "|" + seat;
+    return line;
 }
 
 // Display registration info to console
@@ -43,5 +55,7 @@ string Registration::toFileFormat() const {
 // Used by: Admin when viewing registration reports
 void Registration::display() const {
     cout << "  " << studentUsername << " -> " << eventName 
-         << " (Registered: " << registrationDate << ")" << endl;
+         << " (Registered: " << registrationDate;
+    if (!seat.empty()) cout << ", Seat " << seat;
+    cout << ")" << '\n';    // '\n' doesn't flush, unlike endl
 }
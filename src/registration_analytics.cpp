@@ -0,0 +1,209 @@
+#include "registration_analytics.h"
+#include "registration_velocity.h"
+#include "event_schedule.h"
+#include "thread_pool.h"
+#include "metrics.h"
+#include "utils.h"
+#include <string_view>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
+// ========================================
+// REGISTRATION_ANALYTICS.CPP - Streaming Time-Bucket Histograms
+// ========================================
+// This file counts when students register without loading the registrations.
+// Steps: read a few blocks of the file (each cut after a newline) → count every block on
+// the thread pool into its own small histogram → merge the histograms → read the next blocks.
+// Only the counts outlive a block, so memory depends on the block size, not the file size.
+// Demonstrates: Streaming aggregation, bounded buffers, map-reduce over the thread pool
+
+// Bytes read into one block (a block also holds the partial line carried over from the last one)
+static const size_t BLOCK_SIZE = 4 << 20;    // 4 MB
+
+// One block's counts; event names are views into the block, so they are copied out on merge
+struct BlockCounts {
+    long long byHourOfDay[24] = {};
+    unordered_map<long long, long long> byDay;
+    unordered_map<string_view, long long> byEvent;
+    long long registrations = 0;
+    long long waitlistEntries = 0;
+    long long unreadableLines = 0;
+};
+
+// Remove spaces/tabs/CR from both ends of a view
+static string_view trimView(string_view s) {
+    size_t first = s.find_first_not_of(" \t\n\r");
+    if (first == string_view::npos) return string_view();
+    size_t last = s.find_last_not_of(" \t\n\r");
+    return s.substr(first, last - first + 1);
+}
+
+// Count the registrations in one block of whole lines
+// What it does: Splits each line on '|' in place; registrations (3 or 4 fields) are counted
+// by the hour and day of their date and by event, waitlist entries (6 fields) are only tallied
+// and seat holds (5 fields) are skipped
+static void countBlock(string_view text, BlockCounts& counts) {
+    size_t p = 0;
+    while (p < text.size()) {
+        size_t lineEnd = text.find('\n', p);
+        if (lineEnd == string_view::npos) lineEnd = text.size();
+        string_view line = text.substr(p, lineEnd - p);
+        p = lineEnd + 1;
+
+        string_view trimmed = trimView(line);
+        if (trimmed.empty() || trimmed[0] == '#') continue;    // Skip empty lines and the checkpoint header
+
+        string_view fields[6];
+        size_t fieldCount = 0;
+        size_t start = 0;
+        while (true) {
+            size_t bar = line.find('|', start);
+            string_view field = line.substr(start, bar == string_view::npos ? string_view::npos : bar - start);
+            if (fieldCount < 6) fields[fieldCount] = trimView(field);
+            fieldCount = fieldCount + 1;
+            if (bar == string_view::npos) break;
+            start = bar + 1;
+        }
+
+        if (fieldCount == 6 && fields[3] == "WAITLIST") {
+            counts.waitlistEntries = counts.waitlistEntries + 1;
+            continue;
+        }
+        if (fieldCount == 5 && fields[3] == "HOLD") continue;    // A seat hold is not a registration yet
+        long long minute = 0;
+        if ((fieldCount != 3 && fieldCount != 4) || !parseRegistrationTime(fields[2], minute)) {
+            counts.unreadableLines = counts.unreadableLines + 1;
+            continue;
+        }
+        counts.registrations = counts.registrations + 1;
+        counts.byHourOfDay[minute % 1440 / 60] += 1;
+        counts.byDay[minute / 1440] += 1;
+        counts.byEvent[fields[1]] += 1;
+    }
+}
+
+// Add one block's counts to the running totals
+static void mergeBlock(const BlockCounts& counts, RegistrationHistogram& histogram) {
+    for (int hour = 0; hour < 24; hour = hour + 1) {
+        histogram.byHourOfDay[hour] += counts.byHourOfDay[hour];
+    }
+    for (auto& day : counts.byDay) {
+        histogram.byDay[day.first] += day.second;
+    }
+    for (auto& event : counts.byEvent) {
+        histogram.byEvent[string(event.first)] += event.second;
+    }
+    histogram.registrations = histogram.registrations + counts.registrations;
+    histogram.waitlistEntries = histogram.waitlistEntries + counts.waitlistEntries;
+    histogram.unreadableLines = histogram.unreadableLines + counts.unreadableLines;
+}
+
+// Read the next block: the carried-over partial line plus up to BLOCK_SIZE new bytes,
+// cut just after its last newline (the rest is carried into the next block)
+// A line longer than a whole block keeps the block growing until its newline arrives.
+// Returns false once the file is used up and nothing is left.
+static bool readBlock(int fd, string& carry, string& block, bool& atEnd) {
+    block.swap(carry);
+    carry.clear();
+    while (true) {
+        size_t filled = block.size();
+        block.resize(filled + BLOCK_SIZE);
+        while (filled < block.size()) {
+            ssize_t got = read(fd, &block[filled], block.size() - filled);
+            if (got <= 0) {
+                atEnd = true;
+                break;
+            }
+            filled = filled + static_cast<size_t>(got);
+        }
+        block.resize(filled);
+        if (atEnd) return !block.empty();
+
+        size_t lastNewline = block.rfind('\n');
+        if (lastNewline != string::npos) {
+            carry.assign(block, lastNewline + 1, string::npos);
+            block.resize(lastNewline + 1);
+            return true;
+        }
+    }
+}
+
+// Stream the file through the block buffers
+bool analyzeRegistrationTimes(const string& path, RegistrationHistogram& histogram, bool parallel) {
+    OperationScope scope("analyzeRegistrationTimes");
+    histogram = RegistrationHistogram();
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);    // One front-to-back pass: let the kernel read ahead
+
+    ThreadPool& pool = ThreadPool::instance();
+    size_t workers = parallel ? max<size_t>(1, pool.size()) : 1;
+    vector<string> blocks(workers);
+    vector<BlockCounts> counts(workers);
+    string carry;
+    bool atEnd = false;
+
+    // One round: fill up to one block per worker, count them all, fold them into the totals
+    while (!atEnd) {
+        size_t filled = 0;
+        while (filled < workers && !atEnd) {
+            if (readBlock(fd, carry, blocks[filled], atEnd)) filled = filled + 1;
+        }
+        for (size_t i = 0; i < filled; i = i + 1) {
+            counts[i] = BlockCounts();
+        }
+
+        if (filled == 1) {
+            countBlock(blocks[0], counts[0]);
+        } else if (filled > 1) {
+            TaskGroup group(pool);
+            for (size_t i = 0; i < filled; i = i + 1) {
+                group.submit([&blocks, &counts, i]() {
+                    countBlock(blocks[i], counts[i]);
+                });
+            }
+            group.wait();
+        }
+
+        for (size_t i = 0; i < filled; i = i + 1) {
+            mergeBlock(counts[i], histogram);
+        }
+    }
+
+    close(fd);
+    return true;
+}
+
+// Per-venue totals
+// What it does: Looks up each counted event's venue (first event of that name wins, like
+// the store's name index) and adds its count to the venue, then sorts busiest first
+vector<VenueRegistrations> registrationsByVenue(const RegistrationHistogram& histogram,
+                                                const vector<Event>& events) {
+    unordered_map<string, string> venueOf;
+    for (size_t i = 0; i < events.size(); i = i + 1) {
+        venueOf.emplace(events[i].getEventName(), events[i].getVenue());
+    }
+
+    unordered_map<string, VenueRegistrations> venues;
+    for (auto& event : histogram.byEvent) {
+        auto venue = venueOf.find(event.first);
+        string name = venue == venueOf.end() ? string("(deleted events)") : trim(venue->second);
+        // '|' can't appear in a venue name (it separates the fields), so it can't clash with a venue
+        VenueRegistrations& total = venues[venue == venueOf.end() ? string("|deleted") : venueKey(name)];
+        if (total.venue.empty()) total.venue = name;
+        total.registrations = total.registrations + event.second;
+    }
+
+    vector<VenueRegistrations> result;
+    result.reserve(venues.size());
+    for (auto& venue : venues) {
+        result.push_back(venue.second);
+    }
+    sort(result.begin(), result.end(), [](const VenueRegistrations& a, const VenueRegistrations& b) {
+        if (a.registrations != b.registrations) return a.registrations > b.registrations;
+        return a.venue < b.venue;
+    });
+    return result;
+}
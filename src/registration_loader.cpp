@@ -0,0 +1,203 @@
+#include "registration_loader.h"
+#include "thread_pool.h"
+#include "metrics.h"
+#include <string_view>
+#include <charconv>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ========================================
+// REGISTRATION_LOADER.CPP - Parallel Chunked Parser
+// ========================================
+// This file loads registrations.txt using all CPU cores.
+// Steps: map the file into memory → cut it into chunks that end on a newline →
+// parse every chunk on the thread pool into its own buffer → join the buffers in order.
+// Demonstrates: Memory-mapped files, string_view, splitting work across threads
+
+// Files smaller than this are parsed on the calling thread (threads would cost more than they save)
+static const size_t PARALLEL_THRESHOLD = 1 << 20;    // 1 MB
+
+// Target size of one chunk handed to a worker
+static const size_t CHUNK_SIZE = 4 << 20;            // 4 MB
+
+// Everything one worker produces for its chunk
+struct ChunkResult {
+    vector<Registration> registrations;
+    vector<WaitlistEntry> waitlist;
+    vector<HoldEntry> holds;
+    vector<ParseError> errors;    // lineNumber is relative to the chunk until the merge
+    size_t lineCount = 0;
+};
+
+// Remove spaces/tabs/CR from both ends of a view (no copying, unlike trim())
+static string_view trimView(string_view s) {
+    size_t first = s.find_first_not_of(" \t\n\r");
+    if (first == string_view::npos) return string_view();
+    size_t last = s.find_last_not_of(" \t\n\r");
+    return s.substr(first, last - first + 1);
+}
+
+// Read a whole field as a number (false if it isn't one)
+template <typename T>
+static bool parseNumber(string_view text, T& value) {
+    auto result = from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == errc() && result.ptr == text.data() + text.size();
+}
+
+// Parse one chunk of the file
+// What it does: Walks the bytes line by line, splitting each line on '|' in place
+// A registration has 3 fields (4 with an assigned seat), a waitlist entry exactly 6 (4th = WAITLIST)
+// and a seat hold exactly 5 (4th = HOLD); anything else is recorded as an error
+static void parseChunk(const char* begin, const char* end, ChunkResult& result) {
+    const char* p = begin;
+    while (p < end) {
+        const char* lineEnd = p;
+        while (lineEnd < end && *lineEnd != '\n') lineEnd = lineEnd + 1;
+
+        result.lineCount = result.lineCount + 1;
+        string_view line(p, lineEnd - p);
+        p = lineEnd + 1;
+
+        string_view trimmed = trimView(line);
+        if (trimmed.empty() || trimmed[0] == '#') continue;    // Skip empty lines and the checkpoint header
+
+        string_view fields[6];
+        size_t fieldCount = 0;
+        size_t start = 0;
+        while (true) {
+            size_t bar = line.find('|', start);
+            string_view field = line.substr(start, bar == string_view::npos ? string_view::npos : bar - start);
+            if (fieldCount < 6) fields[fieldCount] = trimView(field);
+            fieldCount = fieldCount + 1;
+            if (bar == string_view::npos) break;
+            start = bar + 1;
+        }
+
+        if (fieldCount == 3 || (fieldCount == 4 && !fields[3].empty())) {
+            result.registrations.push_back(Registration(string(fields[0]), string(fields[1]), string(fields[2]),
+                                                        fieldCount == 4 ? string(fields[3]) : string()));
+            continue;
+        }
+
+        WaitlistEntry entry;
+        if (fieldCount == 6 && fields[3] == "WAITLIST" &&
+            parseNumber(fields[4], entry.priority) && parseNumber(fields[5], entry.sequence)) {
+            entry.username = string(fields[0]);
+            entry.eventName = string(fields[1]);
+            entry.joinDate = string(fields[2]);
+            result.waitlist.push_back(entry);
+            continue;
+        }
+
+        HoldEntry hold;
+        if (fieldCount == 5 && fields[3] == "HOLD" && parseNumber(fields[4], hold.expiresAt)) {
+            hold.username = string(fields[0]);
+            hold.eventName = string(fields[1]);
+            hold.holdDate = string(fields[2]);
+            result.holds.push_back(hold);
+            continue;
+        }
+
+        result.errors.push_back(ParseError{ result.lineCount, string(trimView(line)) });
+    }
+}
+
+string HoldEntry::toFileFormat() const {
+    return username + "|" + eventName + "|" + holdDate + "|HOLD|" + to_string(expiresAt);
+}
+
+// Load and parse registrations.txt
+bool loadRegistrationsParallel(const string& path, vector<Registration>& out, vector<WaitlistEntry>& waitlist,
+                               vector<HoldEntry>& holds, vector<ParseError>& errors) {
+    OperationScope scope("loadRegistrationsParallel");
+    out.clear();
+    waitlist.clear();
+    holds.clear();
+    errors.clear();
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    if (size == 0) {
+        close(fd);
+        return true;
+    }
+
+    // Map the whole file: pages are read on demand and shared by every worker
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return false;
+    const char* data = static_cast<const char*>(mapped);
+    const char* end = data + size;
+
+    // Cut the file into chunks; every chunk boundary is moved forward to just after a newline
+    // so that no line is split between two workers
+    vector<pair<const char*, const char*>> chunks;
+    if (size < PARALLEL_THRESHOLD) {
+        chunks.push_back(make_pair(data, end));
+    } else {
+        const char* chunkStart = data;
+        while (chunkStart < end) {
+            const char* chunkEnd = chunkStart + CHUNK_SIZE;
+            if (chunkEnd >= end) {
+                chunkEnd = end;
+            } else {
+                while (chunkEnd < end && *(chunkEnd - 1) != '\n') chunkEnd = chunkEnd + 1;
+            }
+            chunks.push_back(make_pair(chunkStart, chunkEnd));
+            chunkStart = chunkEnd;
+        }
+    }
+
+    // Parse: one task per chunk, each writing only to its own result slot
+    vector<ChunkResult> results(chunks.size());
+    if (chunks.size() == 1) {
+        parseChunk(chunks[0].first, chunks[0].second, results[0]);
+    } else {
+        TaskGroup group(ThreadPool::instance());
+        for (size_t i = 0; i < chunks.size(); i = i + 1) {
+            group.submit([&chunks, &results, i]() {
+                parseChunk(chunks[i].first, chunks[i].second, results[i]);
+            });
+        }
+        group.wait();
+    }
+
+    munmap(mapped, size);
+
+    // Merge in file order; a chunk's line numbers are offset by the lines in all earlier chunks
+    size_t total = 0;
+    for (size_t i = 0; i < results.size(); i = i + 1) {
+        total = total + results[i].registrations.size();
+    }
+    out.reserve(total);
+
+    size_t linesBefore = 0;
+    for (size_t i = 0; i < results.size(); i = i + 1) {
+        for (size_t j = 0; j < results[i].registrations.size(); j = j + 1) {
+            out.push_back(move(results[i].registrations[j]));
+        }
+        for (size_t j = 0; j < results[i].waitlist.size(); j = j + 1) {
+            waitlist.push_back(move(results[i].waitlist[j]));
+        }
+        for (size_t j = 0; j < results[i].holds.size(); j = j + 1) {
+            holds.push_back(move(results[i].holds[j]));
+        }
+        for (size_t j = 0; j < results[i].errors.size(); j = j + 1) {
+            ParseError error = results[i].errors[j];
+            error.lineNumber = error.lineNumber + linesBefore;
+            errors.push_back(error);
+        }
+        linesBefore = linesBefore + results[i].lineCount;
+    }
+
+    return true;
+}
@@ -0,0 +1,70 @@
+#include "registration_velocity.h"
+#include "event_ranking.h"
+#include <ctime>
+
+// ========================================
+// REGISTRATION_VELOCITY.CPP - Sliding-Window Registration Rates
+// ========================================
+// This file turns registration timestamps into minutes and counts them in per-event
+// rings of per-minute buckets, so "how fast is this event filling up" costs the same
+// whether it has ten registrations or a hundred thousand.
+// Demonstrates: Ring buffers, sliding windows, fixed-format parsing
+
+// Two digits at text[at] as a number, or -1
+static int twoDigits(string_view text, size_t at) {
+    char high = text[at], low = text[at + 1];
+    if (high < '0' || high > '9' || low < '0' || low > '9') return -1;
+    return (high - '0') * 10 + (low - '0');
+}
+
+bool parseRegistrationTime(string_view text, long long& minute) {
+    if (text.size() != 16 || text[2] != '-' || text[5] != '-' || text[10] != ' ' || text[13] != ':') return false;
+    int day = twoDigits(text, 0);
+    int month = twoDigits(text, 3);
+    int century = twoDigits(text, 6);
+    int yearInCentury = twoDigits(text, 8);
+    int hour = twoDigits(text, 11);
+    int minuteOfHour = twoDigits(text, 14);
+    if (day < 1 || day > 31 || month < 1 || month > 12 || century < 0 || yearInCentury < 0 ||
+        hour < 0 || hour > 23 || minuteOfHour < 0 || minuteOfHour > 59) {
+        return false;
+    }
+    long long days = civilDayNumber(century * 100 + yearInCentury, month, day);
+    minute = days * 1440 + hour * 60 + minuteOfHour;
+    return true;
+}
+
+long long currentMinute() {
+    time_t now = time(0);
+    tm* local = localtime(&now);
+    return civilDayNumber(local->tm_year + 1900, local->tm_mon + 1, local->tm_mday) * 1440 +
+           local->tm_hour * 60 + local->tm_min;
+}
+
+// Constructor - every bucket starts empty
+RateWindow::RateWindow() {
+    for (int i = 0; i < MINUTES; i = i + 1) {
+        bucketMinute[i] = -1;
+        bucketCount[i] = 0;
+    }
+}
+
+void RateWindow::record(long long minute, int count) {
+    if (minute < 0) return;
+    int slot = static_cast<int>(minute % MINUTES);
+    if (bucketMinute[slot] > minute) return;    // The bucket already moved on to a later hour
+    if (bucketMinute[slot] != minute) {
+        bucketMinute[slot] = minute;
+        bucketCount[slot] = 0;
+    }
+    bucketCount[slot] = bucketCount[slot] + count;
+}
+
+// Only buckets whose minute falls inside the window count; stale ones are simply skipped
+int RateWindow::countSince(long long now, int minutes) const {
+    int total = 0;
+    for (int i = 0; i < MINUTES; i = i + 1) {
+        if (bucketMinute[i] > now - minutes && bucketMinute[i] <= now) total = total + bucketCount[i];
+    }
+    return total;
+}
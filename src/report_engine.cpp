@@ -0,0 +1,130 @@
+#include "report_engine.h"
+#include "thread_pool.h"
+#include "metrics.h"
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+
+// ========================================
+// REPORT_ENGINE.CPP - Parallel Participant Reports
+// ========================================
+// This file builds the participant list of every event at once.
+// Registrations are grouped by event in one pass, then each event's report is formatted
+// into its own string buffer on the thread pool. Nothing is printed while building,
+// so the buffers can be written out in bulk at the end.
+// Demonstrates: Parallel tasks, hash map grouping, bulk file output
+
+// Format one event's report into 'report.text'
+// Same layout as the single-event view in Admin::viewRegistrationReports
+static void formatReport(const Event& event, const vector<const Registration*>& participants, EventReport& report) {
+    string& out = report.text;
+    out.reserve(128 + participants.size() * 64);
+
+    out += "=== PARTICIPANTS FOR: " + event.getEventName() + " ===\n";
+    out += "Date: " + event.getDate() + " | Venue: " + event.getVenue() + "\n";
+
+    int count = 0;
+    for (size_t i = 0; i < participants.size(); i = i + 1) {
+        count = count + 1;
+        out += "  " + to_string(count) + ". " + participants[i]->getStudentUsername()
+             + " (Registered: " + participants[i]->getRegistrationDate() + ")\n";
+    }
+
+    if (count == 0) {
+        out += "No registrations for this event!\n";
+    } else {
+        out += "\nTotal Participants: " + to_string(count) + "\n";
+    }
+
+    report.eventName = event.getEventName();
+    report.participantCount = count;
+}
+
+// Build every event's report
+// What it does: Groups registrations by event name (one pass), then formats all reports in parallel
+vector<EventReport> buildAllEventReports(const ChunkedTable<Event>& events,
+                                         const ChunkedTable<Registration>& registrations) {
+    OperationScope scope("buildAllEventReports");
+
+    // Step 1: event name → its registrations, in file order (pointers, so nothing is copied)
+    unordered_map<string, vector<const Registration*>> byEvent;
+    byEvent.reserve(events.size());
+    for (size_t i = 0; i < registrations.size(); i = i + 1) {
+        byEvent[registrations[i].getEventName()].push_back(&registrations[i]);
+    }
+
+    // Step 2: one task per event, each filling only its own slot of 'reports'
+    vector<EventReport> reports(events.size());
+    static const vector<const Registration*> noParticipants;
+    TaskGroup group(ThreadPool::instance());
+    for (size_t i = 0; i < events.size(); i = i + 1) {
+        auto found = byEvent.find(events[i].getEventName());
+        const vector<const Registration*>* participants = (found != byEvent.end()) ? &found->second : &noParticipants;
+        group.submit([&events, &reports, participants, i]() {
+            formatReport(events[i], *participants, reports[i]);
+        });
+    }
+    group.wait();
+
+    return reports;
+}
+
+// Turn an event name into a safe file name ("Tech Fest 2025" → "Tech_Fest_2025")
+static string safeFileName(const string& name) {
+    string result;
+    for (char c : name) {
+        if (isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_') {
+            result += c;
+        } else {
+            result += '_';
+        }
+    }
+    return result.empty() ? "event" : result;
+}
+
+// Write one file per event
+// Different names can clean up to the same file name ("AI/ML" and "AI ML" → "AI_ML"),
+// so a name that is already taken gets a number ("AI_ML_2") instead of overwriting a report
+int writeReportsPerEvent(const vector<EventReport>& reports, const string& directory) {
+    OperationScope scope("writeReportsPerEvent");
+    error_code ec;
+    filesystem::create_directories(directory, ec);
+
+    unordered_set<string> taken;
+    taken.reserve(reports.size());
+    int written = 0;
+    for (size_t i = 0; i < reports.size(); i = i + 1) {
+        string base = safeFileName(reports[i].eventName);
+        string fileName = base;
+        int suffix = 2;
+        while (!taken.insert(fileName).second) {
+            fileName = base + "_" + to_string(suffix);
+            suffix = suffix + 1;
+        }
+        ofstream file(directory + "/" + fileName + ".txt", ios::binary);
+        if (!file.is_open()) continue;
+        file.write(reports[i].text.data(), static_cast<streamsize>(reports[i].text.size()));
+        if (file) written = written + 1;
+    }
+    return written;
+}
+
+// Write every report into one file, separated by blank lines
+bool writeCombinedReport(const vector<EventReport>& reports, const string& path) {
+    OperationScope scope("writeCombinedReport");
+    filesystem::path parent = filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        error_code ec;
+        filesystem::create_directories(parent, ec);
+    }
+
+    ofstream file(path, ios::binary);
+    if (!file.is_open()) return false;
+
+    for (size_t i = 0; i < reports.size(); i = i + 1) {
+        file.write(reports[i].text.data(), static_cast<streamsize>(reports[i].text.size()));
+        file.put('\n');
+    }
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,143 @@
+#include "seat_map.h"
+#include <algorithm>
+#include <cstdlib>
+
+// ========================================
+// SEAT_MAP.CPP - Packed Bitset Seat Maps
+// ========================================
+// This file keeps track of taken seats, one bit per seat, and finds the best block of
+// adjacent free seats. The search never looks at seats one by one: it works on whole
+// 64-bit words (shifts, AND, popcount, count-trailing-zeros).
+// Demonstrates: Bitsets, bit tricks, run detection by doubling
+
+static const int WORD_BITS = 64;
+
+string formatSeat(int row, int seat) {
+    return to_string(row) + "-" + to_string(seat);
+}
+
+bool parseSeat(const string& text, int& row, int& seat) {
+    size_t dash = text.find('-');
+    if (dash == string::npos || dash == 0 || dash + 1 >= text.size()) return false;
+    for (size_t i = 0; i < text.size(); i = i + 1) {
+        if (i != dash && (text[i] < '0' || text[i] > '9')) return false;
+    }
+    if (dash > 6 || text.size() - dash - 1 > 6) return false;
+    row = stoi(text.substr(0, dash));
+    seat = stoi(text.substr(dash + 1));
+    return row > 0 && seat > 0;
+}
+
+// Constructor - every seat starts free
+SeatMap::SeatMap(int rowCount, int rowLength)
+    : rows(max(0, rowCount)), seatsPerRow(max(0, rowLength)),
+      wordsPerRow((max(0, rowLength) + WORD_BITS - 1) / WORD_BITS), takenSeats(0),
+      taken(static_cast<size_t>(rows) * static_cast<size_t>(wordsPerRow), 0) {}
+
+int SeatMap::getRows() const {
+    return rows;
+}
+
+int SeatMap::getSeatsPerRow() const {
+    return seatsPerRow;
+}
+
+int SeatMap::getFreeSeats() const {
+    return rows * seatsPerRow - takenSeats;
+}
+
+bool SeatMap::isTaken(int row, int seat) const {
+    if (row < 1 || row > rows || seat < 1 || seat > seatsPerRow) return false;
+    size_t bit = static_cast<size_t>(seat - 1);
+    return (taken[(row - 1) * wordsPerRow + bit / WORD_BITS] >> (bit % WORD_BITS)) & 1;
+}
+
+bool SeatMap::take(int row, int seat) {
+    if (row < 1 || row > rows || seat < 1 || seat > seatsPerRow || isTaken(row, seat)) return false;
+    size_t bit = static_cast<size_t>(seat - 1);
+    taken[(row - 1) * wordsPerRow + bit / WORD_BITS] |= uint64_t(1) << (bit % WORD_BITS);
+    takenSeats = takenSeats + 1;
+    return true;
+}
+
+void SeatMap::release(int row, int seat) {
+    if (!isTaken(row, seat)) return;
+    size_t bit = static_cast<size_t>(seat - 1);
+    taken[(row - 1) * wordsPerRow + bit / WORD_BITS] &= ~(uint64_t(1) << (bit % WORD_BITS));
+    takenSeats = takenSeats - 1;
+}
+
+// out = in shifted towards seat 1 by 'by' seats (bit i of out = bit i + by of in)
+static void shiftDown(const vector<uint64_t>& in, int by, vector<uint64_t>& out) {
+    size_t words = in.size();
+    size_t wordShift = static_cast<size_t>(by / WORD_BITS);
+    int bitShift = by % WORD_BITS;
+    for (size_t w = 0; w < words; w = w + 1) {
+        uint64_t low = (w + wordShift < words) ? in[w + wordShift] : 0;
+        uint64_t high = (w + wordShift + 1 < words) ? in[w + wordShift + 1] : 0;
+        out[w] = (bitShift == 0) ? low : (low >> bitShift) | (high << (WORD_BITS - bitShift));
+    }
+}
+
+// Find the best block of free seats
+// What it does: For each row, turns the taken bits into a free mask and then into a mask of
+// block starts: bit i ends up set only if seats i .. i+count-1 are all free. That takes
+// log2(count) steps, each one AND with a copy of itself shifted by the length covered so far.
+// The set bits are then visited with count-trailing-zeros to pick the most central start.
+// Rows without enough free seats (popcount) are skipped at once.
+bool SeatMap::findBest(int count, int& bestRow, int& bestSeat) const {
+    if (count <= 0 || count > seatsPerRow) return false;
+    vector<uint64_t> starts(wordsPerRow);
+    vector<uint64_t> shifted(wordsPerRow);
+    int tailBits = seatsPerRow % WORD_BITS;
+
+    for (int r = 0; r < rows; r = r + 1) {
+        const uint64_t* row = &taken[static_cast<size_t>(r) * wordsPerRow];
+        int freeInRow = 0;
+        for (int w = 0; w < wordsPerRow; w = w + 1) {
+            uint64_t valid = (w == wordsPerRow - 1 && tailBits != 0) ? (uint64_t(1) << tailBits) - 1 : ~uint64_t(0);
+            starts[w] = ~row[w] & valid;
+            freeInRow = freeInRow + __builtin_popcountll(starts[w]);
+        }
+        if (freeInRow < count) continue;
+
+        int covered = 1;
+        while (covered < count) {
+            int step = min(covered, count - covered);
+            shiftDown(starts, step, shifted);
+            for (int w = 0; w < wordsPerRow; w = w + 1) {
+                starts[w] = starts[w] & shifted[w];
+            }
+            covered = covered + step;
+        }
+
+        int best = -1;
+        int bestDistance = 0;
+        for (int w = 0; w < wordsPerRow; w = w + 1) {
+            uint64_t remaining = starts[w];
+            while (remaining != 0) {
+                int start = w * WORD_BITS + __builtin_ctzll(remaining);
+                int distance = abs(2 * start + count - seatsPerRow);    // Twice the block centre's offset from the row centre
+                if (best < 0 || distance < bestDistance) {
+                    best = start;
+                    bestDistance = distance;
+                }
+                remaining = remaining & (remaining - 1);
+            }
+        }
+        if (best >= 0) {
+            bestRow = r + 1;
+            bestSeat = best + 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+string SeatMap::rowPicture(int row) const {
+    string picture;
+    for (int s = 1; s <= seatsPerRow; s = s + 1) {
+        picture += isTaken(row, s) ? '#' : '.';
+    }
+    return picture;
+}
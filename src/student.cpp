@@ -6,6 +6,13 @@
 // This file implements the Student class which inherits from User.
 // Students can: browse events, register/unregister, view their registrations, search events.
 // Demonstrates: Inheritance, File I/O, Vector manipulation, Searching/Filtering
+
+// How long a seat stays held while a student confirms a registration
+static const int SEAT_HOLD_MINUTES = 10;
+
+// How many events "Recommended For You" suggests
+static const size_t RECOMMENDATION_COUNT = 5;
+
 // Constructor with base class initialization
 // What it does: Creates a Student object by passing data to the User constructor
 // The colon syntax calls the parent class (User) constructor
@@ -20,7 +27,9 @@ void Student::displayMenu() {
     cout << "1. Browse Available Events" << endl;    // View and register for events
     cout << "2. My Registrations" << endl;           // See what they're registered for
     cout << "3. Search Events" << endl;              // Search by name or filter by date
-    cout << "4. Logout" << endl;                     // Exit student portal
+    cout << "4. Register for Multiple Events" << endl; // Cart: all or nothing
+    cout << "5. Recommended For You" << endl;        // Events popular with similar students
+    cout << "6. Logout" << endl;                     // Exit student portal
     cout << "Choose an option: ";
 }
 
@@ -32,117 +41,48 @@ string Student::getUserType() {
 }
 
 // ==================== FILE I/O OPERATIONS ====================
-// Students need to read/write events and registrations files
-// These functions are similar to Admin's but Student doesn't have extra features
+// Students share the same EventStore as Admin (event_store.cpp), so these are thin wrappers
 
-// Load events from file
-// What it does: Reads events.txt and creates Event objects
+// Load events
+// What it does: Returns a copy of the events table
 // Why students need this: To browse available events
 vector<Event> Student::loadEventsFromFile() {
-    vector<Event> events;
-    ifstream file("data/events.txt");
-    string line;
-    
-    if (!file.is_open()) {
-        return events;    // Return empty vector if file doesn't exist
-    }
-    
-    // Read and parse each line
-    while (getline(file, line)) {
-        if (line.empty()) continue;
-        
-        vector<string> parts = split(line, '|');
-        if (parts.size() >= 4) {
-            string name = trim(parts[0]);
-            string date = trim(parts[1]);
-            string venue = trim(parts[2]);
-            int capacity = static_cast<int>(stoi(trim(parts[3])));
-            int registered = (parts.size() > 4) ? static_cast<int>(stoi(trim(parts[4]))) : 0;
-            
-            events.push_back(Event(name, date, venue, capacity, registered));
-        }
-    }
-    
-    file.close();
-    return events;
+    OperationScope scope("Student::loadEventsFromFile");
+    return EventStore::instance().getEvents();
 }
 
-// Save events to file
-// What it does: Writes updated events back to file
-// Why students need this: When they register/unregister, the registered count changes
+// Save events
+// What it does: Replaces the whole events table and writes events.txt
 bool Student::saveEventsToFile(const vector<Event>& events) {
-    ofstream file("data/events.txt");
-    
-    if (!file.is_open()) {
-        return false;
-    }
-    
-    for (size_t i = 0; i < events.size(); i = i + 1) {
-        file << events[i].toFileFormat() << endl;
-    }
-    
-    file.close();
-    return true;
+    OperationScope scope("Student::saveEventsToFile");
+    return EventStore::instance().saveEvents(events);
 }
 
-// Load registrations from file
-// What it does: Reads all registrations to check what events user is registered for
+// Load registrations
+// What it does: Returns a copy of the registrations table
 vector<Registration> Student::loadRegistrationsFromFile() {
-    vector<Registration> registrations;
-    ifstream file("data/registrations.txt");
-    string line;
-    
-    if (!file.is_open()) {
-        return registrations;
-    }
-    
-    while (getline(file, line)) {
-        if (line.empty()) continue;
-        
-        vector<string> parts = split(line, '|');
-        if (parts.size() == 3) {
-            registrations.push_back(Registration(trim(parts[0]), trim(parts[1]), trim(parts[2])));
-        }
-    }
-    
-    file.close();
-    return registrations;
+    OperationScope scope("Student::loadRegistrationsFromFile");
+    return EventStore::instance().getRegistrations();
 }
 
-// Save registrations to file
-// What it does: Writes updated registrations back to file
-// Called when: Student registers or unregisters from an event
+// Save registrations
+// What it does: Replaces the whole registrations table and writes registrations.txt
 bool Student::saveRegistrationsToFile(const vector<Registration>& registrations) {
-    ofstream file("data/registrations.txt");
-    
-    if (!file.is_open()) {
-        return false;
-    }
-    
-    for (size_t i = 0; i < registrations.size(); i = i + 1) {
-        file << registrations[i].toFileFormat() << endl;
-    }
-    
-    file.close();
-    return true;
+    OperationScope scope("Student::saveRegistrationsToFile");
+    return EventStore::instance().saveRegistrations(registrations);
 }
 
 // Get current date and time
-// What it does: Returns current system date/time as a formatted string
-// Used when: Recording when a student registered for an event
-// Returns: String in format "DD-MM-YYYY HH:MM"
+// What it does: Returns current system date/time as a formatted string ("DD-MM-YYYY HH:MM")
+// The formatting lives in utils.cpp because the store also needs it for waitlist promotions
 string Student::getCurrentDateTime() {
-    time_t now = time(0);                  // Get current time as seconds since epoch
-    tm* timeinfo = localtime(&now);         // Convert to local time structure
-    char buffer[20];                        // Character array to hold formatted string
-    // strftime formats the time according to the format string
-    strftime(buffer, sizeof(buffer), "%d-%m-%Y %H:%M", timeinfo);
-    return string(buffer);                  // Convert char array to string
+    return currentDateTime();
 }
 
 // View available events for registration
 void Student::viewAvailableEvents() {
-    vector<Event> events = loadEventsFromFile();
+    OperationScope scope("Student::viewAvailableEvents");
+    const vector<Event>& events = EventStore::instance().getEvents();
     
     cout << "\n=== AVAILABLE EVENTS FOR REGISTRATION ===" << endl;
     
@@ -151,37 +91,48 @@ void Student::viewAvailableEvents() {
         return;
     }
     
-    cout << "\n" << string(110, '=') << endl;
-    cout << "  " << left << setw(2) << "#" << "  "
-         << setw(25) << "EVENT NAME" << " | "
-         << setw(12) << "DATE" << " | "
-         << setw(20) << "VENUE" << " | "
-         << setw(4) << "CAP" << " | "
-         << setw(4) << "REG" << " | "
-         << "AVL" << endl;
-    cout << string(110, '=') << endl;
-    
-    for (size_t i = 0; i < events.size(); i++) {
-        events[i].display(i + 1);
+    renderEventTable(cout, events);
+}
+
+// Recommended events
+// What it does: Shows the events most often chosen by students who registered for the
+// same events as this student, with how many such registrations back each suggestion
+void Student::viewRecommendedEvents() {
+    OperationScope scope("Student::viewRecommendedEvents");
+    cout << "\n=== RECOMMENDED FOR YOU ===" << endl;
+    
+    EventStore& store = EventStore::instance();
+    vector<RelatedEvent> related = store.recommendEvents(username, RECOMMENDATION_COUNT);
+    if (related.empty()) {
+        cout << "No recommendations yet - register for an event and check back!" << endl;
+        return;
+    }
+    
+    vector<Event> rows;
+    Event event;
+    for (size_t i = 0; i < related.size(); i = i + 1) {
+        if (store.lookupEvent(related[i].eventName, event)) rows.push_back(event);
+    }
+    renderEventTable(cout, rows);
+    cout << "Students who registered for your events also registered for these:" << endl;
+    for (size_t i = 0; i < related.size(); i = i + 1) {
+        cout << "  " << related[i].eventName << " (" << related[i].score << " shared registration(s))" << endl;
     }
-    cout << string(110, '=') << endl;
 }
 
 // View my registrations
 void Student::viewMyRegistrations() {
-    vector<Event> events = loadEventsFromFile();
-    vector<Registration> registrations = loadRegistrationsFromFile();
+    OperationScope scope("Student::viewMyRegistrations");
+    EventStore& store = EventStore::instance();
+    // Only this student's rows are read (per-student index); event details are fetched one at a time
+    vector<Registration> myRegs = store.getRegistrationsFor(username);
     
     cout << "\n=== MY REGISTRATIONS ===" << endl;
     
-    vector<Registration> myRegs;
-    for (size_t i = 0; i < registrations.size(); i = i + 1) {
-        if (registrations[i].getStudentUsername() == username) {
-            myRegs.push_back(registrations[i]);
-        }
-    }
+    // Full events this student is waiting for
+    vector<WaitlistEntry> myWaits = store.getWaitlist().entriesForUser(username);
     
-    if (myRegs.empty()) {
+    if (myRegs.empty() && myWaits.empty()) {
         cout << "You are not registered for any events!" << endl;
         return;
     }
@@ -192,13 +143,26 @@ void Student::viewMyRegistrations() {
     
     for (size_t i = 0; i < myRegs.size(); i++) {
         cout << i + 1 << ". " << myRegs[i].getEventName() 
-             << " (Registered: " << myRegs[i].getRegistrationDate() << ")" << endl;
+             << " (Registered: " << myRegs[i].getRegistrationDate();
+        if (!myRegs[i].getSeat().empty()) cout << ", Seat " << myRegs[i].getSeat();
+        cout << ")" << endl;
+    }
+    
+    if (!myWaits.empty()) {
+        cout << "\nYou are on the waitlist for " << myWaits.size() << " event(s):" << endl;
+        for (size_t i = 0; i < myWaits.size(); i = i + 1) {
+            cout << "  W" << i + 1 << ". " << myWaits[i].eventName
+                 << " (Joined: " << myWaits[i].joinDate << ")" << endl;
+        }
     }
     
     cout << "\nOptions:" << endl;
     cout << "1. View Event Details" << endl;
     cout << "2. Unregister from Event" << endl;
     cout << "3. Back" << endl;
+    if (!myWaits.empty()) {
+        cout << "4. Leave a Waitlist" << endl;
+    }
     cout << "Choose option: ";
     
     int choice;
@@ -211,13 +175,10 @@ void Student::viewMyRegistrations() {
         cin >> eventNum;
         cin.ignore();
         
-        if (eventNum >= 1 && eventNum <= (int)myRegs.size()) {
-            for (const auto& event : events) {
-                if (event.getEventName() == myRegs[eventNum - 1].getEventName()) {
-                    event.displayDetailed(eventNum);
-                    break;
-                }
-            }
+        Event event;
+        if (eventNum >= 1 && eventNum <= (int)myRegs.size() &&
+            store.lookupEvent(myRegs[eventNum - 1].getEventName(), event)) {
+            event.displayDetailed(eventNum);
         }
     } else if (choice == 2) {
         cout << "Enter event number to unregister: ";
@@ -228,6 +189,19 @@ void Student::viewMyRegistrations() {
         if (eventNum >= 1 && eventNum <= (int)myRegs.size()) {
             unregisterFromEvent(myRegs[eventNum - 1].getEventName());
         }
+    } else if (choice == 4 && !myWaits.empty()) {
+        cout << "Enter waitlist number to leave (the number after W): ";
+        int waitNum;
+        cin >> waitNum;
+        cin.ignore();
+        
+        if (waitNum >= 1 && waitNum <= (int)myWaits.size()) {
+            if (store.leaveWaitlist(username, myWaits[waitNum - 1].eventName)) {
+                cout << "You have left the waitlist for '" << myWaits[waitNum - 1].eventName << "'." << endl;
+            } else {
+                cout << "Error: Could not leave the waitlist!" << endl;
+            }
+        }
     }
 }
 
@@ -237,9 +211,10 @@ void Student::viewMyRegistrations() {
 // What it does: Allows student to sign up for an event
 // Process: Load data → Show events → Get choice → Validate → Update files
 void Student::registerForEvent() {
-    // Load current data from files
-    vector<Event> events = loadEventsFromFile();
-    vector<Registration> registrations = loadRegistrationsFromFile();
+    OperationScope scope("Student::registerForEvent");
+    // Current data from the shared store
+    EventStore& store = EventStore::instance();
+    const vector<Event>& events = store.getEvents();
     
     // Check if there are any events to register for
     if (events.empty()) {
@@ -263,82 +238,172 @@ void Student::registerForEvent() {
     }
     
     // Get reference to the selected event (arrays/vectors are 0-indexed, display is 1-indexed)
-    Event& selectedEvent = events[eventNum - 1];
+    const Event& selectedEvent = events[eventNum - 1];
     string eventName = selectedEvent.getEventName();
     
     // VALIDATION 1: Check if already registered
-    // Loop through all registrations to see if this student already registered for this event
-    for (size_t i = 0; i < registrations.size(); i = i + 1) {
-        if (registrations[i].getStudentUsername() == username && registrations[i].getEventName() == eventName) {
-            cout << "Error: You are already registered for this event!" << endl;
-            return;    // Exit early if duplicate found
-        }
+    // Only this student's own registrations are checked (the store indexes them by username)
+    if (store.isRegistered(username, eventName)) {
+        cout << "Error: You are already registered for this event!" << endl;
+        return;    // Exit early if duplicate found
     }
     
-    // VALIDATION 2: Check if event has capacity
+    // VALIDATION 2: Check the student's timetable
+    // One lookup in their own schedule index (sorted by start time), not a scan of registrations
+    Event clash;
+    if (store.findScheduleClash(username, selectedEvent, clash)) {
+        cout << "Error: This event clashes with '" << clash.getEventName() << "' ("
+             << describeTimeSlot(clash) << "), which you are already registered for!" << endl;
+        return;
+    }
+    
+    // VALIDATION 3: Check if event has capacity
+    // A full event offers a place on its waitlist instead; the student is registered
+    // automatically when a seat frees up
     if (!selectedEvent.hasAvailableSeats()) {
         cout << "Error: Event is full! No available seats." << endl;
+        
+        const Waitlist& waitlist = store.getWaitlist();
+        if (waitlist.contains(username, eventName)) {
+            cout << "You are already on the waitlist for this event." << endl;
+            return;
+        }
+        
+        cout << "Students waiting: " << waitlist.waitingCount(eventName) << endl;
+        cout << "Join the waitlist? (yes/no): ";
+        string answer;
+        getline(cin, answer);
+        if (toLower(trim(answer)) == "yes") {
+            string problem;
+            if (store.joinWaitlist(username, eventNum - 1, getCurrentDateTime(), 0, &problem)) {
+                cout << "You have joined the waitlist for '" << eventName << "'." << endl;
+            } else if (!problem.empty()) {
+                cout << "Error: " << problem << "!" << endl;
+            } else {
+                cout << "Error: Could not join the waitlist!" << endl;
+            }
+        }
         return;
     }
     
-    // All validations passed - proceed with registration
-    // Step 1: Increment the registered count for the event
-    selectedEvent.registerStudent();
-    
-    // Step 2: Create a new Registration object and add it to the vector
-    // 'username' is inherited from User base class
-    registrations.push_back(Registration(username, eventName, getCurrentDateTime()));
+    // Hold a seat while the student confirms, so nobody else can take it meanwhile
+    // A hold that is never confirmed expires by itself after SEAT_HOLD_MINUTES
+    string problem;
+    if (!store.holdSeat(username, eventName, SEAT_HOLD_MINUTES, problem)) {
+        cout << "Error: " << problem << "!" << endl;
+        return;
+    }
+    cout << "\nA seat in '" << eventName << "' is held for you for " << SEAT_HOLD_MINUTES << " minutes." << endl;
+    cout << "Confirm registration? (yes/no): ";
+    string answer;
+    getline(cin, answer);
+    if (toLower(trim(answer)) != "yes") {
+        store.releaseHold(username, eventName);
+        cout << "Registration cancelled. The seat was released." << endl;
+        return;
+    }
     
-    // Step 3: Save both updated vectors back to files
-    // && means "and" - both saves must succeed
-    if (saveEventsToFile(events) && saveRegistrationsToFile(registrations)) {
+    // All validations passed - proceed with registration
+    // The store checks the seat again against every session's registrations before saving;
+    // the held seat is used if the hold is still running ('username' is inherited from User base class)
+    SeatRequest request;
+    request.username = username;
+    request.regDate = getCurrentDateTime();
+    AdmissionResult result = store.admitBatch(eventName, vector<SeatRequest>(1, request))[0];
+    if (result.granted) {
         cout << "\nSuccess! You have been registered for '" << eventName << "'!" << endl;
+        if (!result.seat.empty()) cout << "Your seat: " << result.seat << " (row-seat)" << endl;
     } else {
-        cout << "Error: Registration failed!" << endl;
+        cout << "Error: Registration failed! " << result.reason << endl;
     }
 }
 
-// Unregister from an event
-// What it does: Removes a student's registration from an event
-// Process: Find the registration → Remove it → Update event count → Save files
-void Student::unregisterFromEvent(const string& eventName) {
-    // Load current data
-    vector<Event> events = loadEventsFromFile();
-    vector<Registration> registrations = loadRegistrationsFromFile();
-    
-    // Find the registration manually by looping through the vector
-    size_t index = 0;
-    bool found = false;
-    for (size_t i = 0; i < registrations.size(); ++i) {
-        if (registrations[i].getStudentUsername() == username && registrations[i].getEventName() == eventName) {
-            index = i;
-            found = true;
-            break;
+// Register for several events at once ("cart")
+// What it does: Lets the student pick many events, then registers for all of them
+// in one transaction - either every registration succeeds (one save) or none is made
+void Student::registerForMultipleEvents() {
+    OperationScope scope("Student::registerForMultipleEvents");
+    EventStore& store = EventStore::instance();
+    const vector<Event>& events = store.getEvents();
+    
+    if (events.empty()) {
+        cout << "No events available!" << endl;
+        return;
+    }
+    
+    viewAvailableEvents();
+    
+    cout << "\nEnter event numbers separated by spaces or commas (0 to cancel): ";
+    string line;
+    getline(cin, line);
+    
+    // Turn "1, 3 5" into {0, 2, 4} (0-based indexes)
+    for (char& c : line) {
+        if (c == ',') c = ' ';
+    }
+    vector<size_t> cart;
+    vector<string> parts = split(line, ' ');
+    for (size_t i = 0; i < parts.size(); i = i + 1) {
+        string part = trim(parts[i]);
+        if (part.empty()) continue;
+        if (!isNumeric(part) || part.size() > 9) {
+            cout << "Invalid event number: " << part << endl;
+            return;
         }
+        int number = stoi(part);
+        if (number == 0) {
+            cout << "Cancelled." << endl;
+            return;
+        }
+        cart.push_back(static_cast<size_t>(number - 1));
     }
     
-    // Check if registration was found
-    if (!found) {
-        cout << "Error: Registration not found!" << endl;
+    if (cart.empty()) {
+        cout << "No events selected!" << endl;
         return;
     }
     
-    // Remove the registration from the vector
-    registrations.erase(registrations.begin() + index);
-    
-    // Find the event and decrease its registered count
-    for (auto& event : events) {
-        if (event.getEventName() == eventName) {
-            event.unregisterStudent();    // Decrements registeredCount
-            break;    // Found the event, no need to continue looping
+    cout << "\nYour cart (" << cart.size() << " event(s)):" << endl;
+    for (size_t i = 0; i < cart.size(); i = i + 1) {
+        if (cart[i] < events.size()) {
+            cout << "  - " << events[cart[i]].getEventName() << endl;
         }
     }
+    cout << "Register for all of them? (yes/no): ";
+    string confirmation;
+    getline(cin, confirmation);
+    if (toLower(trim(confirmation)) != "yes") {
+        cout << "Cancelled." << endl;
+        return;
+    }
     
-    // Save updated data back to files
-    if (saveEventsToFile(events) && saveRegistrationsToFile(registrations)) {
+    vector<string> problems;
+    if (store.registerBatch(username, cart, getCurrentDateTime(), problems)) {
+        cout << "\nSuccess! You have been registered for " << cart.size() << " event(s)!" << endl;
+    } else {
+        cout << "\nError: No registrations were made:" << endl;
+        for (size_t i = 0; i < problems.size(); i = i + 1) {
+            cout << "  - " << problems[i] << endl;
+        }
+    }
+}
+
+// Unregister from an event
+// What it does: Removes a student's registration from an event
+// Process: Find the registration → Remove it → Update event count → Save files
+void Student::unregisterFromEvent(const string& eventName) {
+    OperationScope scope("Student::unregisterFromEvent");
+    // The store finds the registration, removes it, gives the seat back
+    // to the event and saves both files - it returns false if there was no such registration
+    // If somebody was waiting, the store also promotes them in the same save
+    vector<WaitlistEntry> promoted;
+    if (EventStore::instance().unregisterStudent(username, eventName, &promoted)) {
         cout << "Success! You have been unregistered from '" << eventName << "'!" << endl;
+        if (!promoted.empty()) {
+            cout << "Your seat went to the next student on the waitlist." << endl;
+        }
     } else {
-        cout << "Error: Unregistration failed!" << endl;
+        cout << "Error: Registration not found!" << endl;
     }
 }
 
@@ -348,7 +413,8 @@ void Student::unregisterFromEvent(const string& eventName) {
 // What it does: Finds events whose names contain the search term (case-insensitive)
 // Example: Searching "tech" will find "Tech Fest 2025" and "Robotech Workshop"
 void Student::searchEventByName() {
-    vector<Event> events = loadEventsFromFile();
+    OperationScope scope("Student::searchEventByName");
+    const vector<Event>& events = EventStore::instance().getEvents();
     
     cout << "\n=== SEARCH EVENTS ===" << endl;
     cout << "Enter event name to search: ";
@@ -365,12 +431,12 @@ void Student::searchEventByName() {
     }
     
     // Search through events and collect matching ones
-    vector<Event> results;    // Vector to store matching events
+    vector<const Event*> results;    // Pointers to matching events (no copies)
     for (size_t i = 0; i < events.size(); i = i + 1) {
         // find() returns string::npos if the substring is not found
         // So if find() doesn't return npos, it means the search term was found
         if (toLower(events[i].getEventName()).find(searchTerm) != string::npos) {
-            results.push_back(events[i]);    // Add matching event to results
+            results.push_back(&events[i]);    // Add matching event to results
         }
     }
     
@@ -382,30 +448,14 @@ void Student::searchEventByName() {
     
     // Display search results in a formatted table
     cout << "\n=== SEARCH RESULTS ===" << endl;
-    cout << "\n" << string(110, '=') << endl;    // string(110, '=') creates a string of 110 '=' characters
-    
-    // Table header
-    cout << "  " << left << setw(2) << "#" << "  "
-         << setw(25) << "EVENT NAME" << " | "
-         << setw(12) << "DATE" << " | "
-         << setw(20) << "VENUE" << " | "
-         << setw(4) << "CAP" << " | "
-         << setw(4) << "REG" << " | "
-         << "AVL" << endl;
-    cout << string(110, '=') << endl;
-    
-    // Display each matching event
-    // size_t is an unsigned integer type for sizes/counts
-    for (size_t i = 0; i < results.size(); i++) {
-        results[i].display(i + 1);    // Display with 1-based numbering
-    }
-    cout << string(110, '=') << endl;
+    renderEventTable(cout, results);    // Rows numbered from 1
     cout << "Found " << results.size() << " event(s)" << endl << endl;
 }
 
 // Filter events by date
 void Student::filterEventsByDate() {
-    vector<Event> events = loadEventsFromFile();
+    OperationScope scope("Student::filterEventsByDate");
+    const vector<Event>& events = EventStore::instance().getEvents();
     
     cout << "\n=== FILTER EVENTS BY DATE ===" << endl;
     cout << "Enter date (DD-MM-YYYY): ";
@@ -419,10 +469,10 @@ void Student::filterEventsByDate() {
         return;
     }
     
-    vector<Event> results;
+    vector<const Event*> results;
     for (size_t i = 0; i < events.size(); i = i + 1) {
         if (events[i].getDate() == searchDate) {
-            results.push_back(events[i]);
+            results.push_back(&events[i]);
         }
     }
     
@@ -432,19 +482,6 @@ void Student::filterEventsByDate() {
     }
     
     cout << "\n=== EVENTS ON " << searchDate << " ===" << endl;
-    cout << "\n" << string(110, '=') << endl;
-    cout << "  " << left << setw(2) << "#" << "  "
-         << setw(25) << "EVENT NAME" << " | "
-         << setw(12) << "DATE" << " | "
-         << setw(20) << "VENUE" << " | "
-         << setw(4) << "CAP" << " | "
-         << setw(4) << "REG" << " | "
-         << "AVL" << endl;
-    cout << string(110, '=') << endl;
-    
-    for (size_t i = 0; i < results.size(); i++) {
-        results[i].display(i + 1);
-    }
-    cout << string(110, '=') << endl;
+    renderEventTable(cout, results);
     cout << "Found " << results.size() << " event(s)" << endl << endl;
 }
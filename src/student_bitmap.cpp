@@ -0,0 +1,286 @@
+#include "student_bitmap.h"
+#include <algorithm>
+#include <iterator>
+
+// ========================================
+// STUDENT_BITMAP.CPP - Roaring-Style Compressed Bitmaps
+// ========================================
+// This file implements the per-event sets of registered students behind the
+// "students in both / either / only" reports. Each operation picks the cheapest way to
+// combine two containers: whole-word logic for two bitsets, bit tests for an array
+// against a bitset, and a sorted merge for two arrays.
+// Demonstrates: Hybrid containers, word-parallel bit operations, sorted merges
+
+size_t RoaringBitmap::findContainer(uint16_t key) const {
+    size_t low = 0, high = containers.size();
+    while (low < high) {
+        size_t middle = (low + high) / 2;
+        if (containers[middle].key < key) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+void RoaringBitmap::toBitset(Container& c) {
+    if (c.isBitset()) return;
+    c.bits.assign(BITSET_WORDS, 0);
+    for (size_t i = 0; i < c.array.size(); i = i + 1) {
+        c.bits[c.array[i] >> 6] |= uint64_t(1) << (c.array[i] & 63);
+    }
+    c.array.clear();
+    c.array.shrink_to_fit();
+}
+
+void RoaringBitmap::shrink(Container& c) {
+    if (!c.isBitset() || c.count > ARRAY_LIMIT) return;
+    c.array.clear();
+    c.array.reserve(c.count);
+    for (size_t w = 0; w < BITSET_WORDS; w = w + 1) {
+        uint64_t word = c.bits[w];
+        while (word != 0) {
+            c.array.push_back(static_cast<uint16_t>(w * 64 + __builtin_ctzll(word)));
+            word = word & (word - 1);
+        }
+    }
+    c.bits.clear();
+    c.bits.shrink_to_fit();
+}
+
+void RoaringBitmap::add(uint32_t value) {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+    size_t position = findContainer(key);
+    if (position == containers.size() || containers[position].key != key) {
+        Container c;
+        c.key = key;
+        containers.insert(containers.begin() + position, c);
+    }
+    Container& c = containers[position];
+    if (c.isBitset()) {
+        uint64_t mask = uint64_t(1) << (low & 63);
+        if (c.bits[low >> 6] & mask) return;
+        c.bits[low >> 6] |= mask;
+    } else {
+        auto at = lower_bound(c.array.begin(), c.array.end(), low);
+        if (at != c.array.end() && *at == low) return;
+        c.array.insert(at, low);
+        if (c.array.size() > ARRAY_LIMIT) toBitset(c);
+    }
+    c.count = c.count + 1;
+}
+
+bool RoaringBitmap::remove(uint32_t value) {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+    size_t position = findContainer(key);
+    if (position == containers.size() || containers[position].key != key) return false;
+    Container& c = containers[position];
+    if (c.isBitset()) {
+        uint64_t mask = uint64_t(1) << (low & 63);
+        if (!(c.bits[low >> 6] & mask)) return false;
+        c.bits[low >> 6] &= ~mask;
+        c.count = c.count - 1;
+        shrink(c);
+    } else {
+        auto at = lower_bound(c.array.begin(), c.array.end(), low);
+        if (at == c.array.end() || *at != low) return false;
+        c.array.erase(at);
+        c.count = c.count - 1;
+    }
+    if (c.count == 0) containers.erase(containers.begin() + position);
+    return true;
+}
+
+bool RoaringBitmap::contains(uint32_t value) const {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+    size_t position = findContainer(key);
+    if (position == containers.size() || containers[position].key != key) return false;
+    const Container& c = containers[position];
+    if (c.isBitset()) return (c.bits[low >> 6] >> (low & 63)) & 1;
+    return binary_search(c.array.begin(), c.array.end(), low);
+}
+
+size_t RoaringBitmap::cardinality() const {
+    size_t total = 0;
+    for (size_t i = 0; i < containers.size(); i = i + 1) {
+        total = total + containers[i].count;
+    }
+    return total;
+}
+
+bool RoaringBitmap::empty() const {
+    return containers.empty();
+}
+
+// a = a AND b (same key)
+void RoaringBitmap::intersectContainers(Container& a, const Container& b) {
+    if (a.isBitset() && b.isBitset()) {
+        uint32_t count = 0;
+        for (size_t w = 0; w < BITSET_WORDS; w = w + 1) {
+            a.bits[w] = a.bits[w] & b.bits[w];
+            count = count + __builtin_popcountll(a.bits[w]);
+        }
+        a.count = count;
+        shrink(a);
+    } else if (a.isBitset()) {
+        // Only b's ids can survive, so the result is an array
+        vector<uint16_t> kept;
+        for (size_t i = 0; i < b.array.size(); i = i + 1) {
+            if ((a.bits[b.array[i] >> 6] >> (b.array[i] & 63)) & 1) kept.push_back(b.array[i]);
+        }
+        a.bits.clear();
+        a.bits.shrink_to_fit();
+        a.array.swap(kept);
+        a.count = static_cast<uint32_t>(a.array.size());
+    } else {
+        size_t kept = 0;
+        if (b.isBitset()) {
+            for (size_t i = 0; i < a.array.size(); i = i + 1) {
+                if ((b.bits[a.array[i] >> 6] >> (a.array[i] & 63)) & 1) {
+                    a.array[kept] = a.array[i];
+                    kept = kept + 1;
+                }
+            }
+            a.array.resize(kept);
+        } else {
+            vector<uint16_t> both;
+            set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), back_inserter(both));
+            a.array.swap(both);
+        }
+        a.count = static_cast<uint32_t>(a.array.size());
+    }
+}
+
+// a = a OR b (same key)
+void RoaringBitmap::unionContainers(Container& a, const Container& b) {
+    if (!a.isBitset() && !b.isBitset() && a.array.size() + b.array.size() <= ARRAY_LIMIT) {
+        vector<uint16_t> either;
+        set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), back_inserter(either));
+        a.array.swap(either);
+        a.count = static_cast<uint32_t>(a.array.size());
+        return;
+    }
+    toBitset(a);
+    uint32_t count = 0;
+    if (b.isBitset()) {
+        for (size_t w = 0; w < BITSET_WORDS; w = w + 1) {
+            a.bits[w] = a.bits[w] | b.bits[w];
+            count = count + __builtin_popcountll(a.bits[w]);
+        }
+    } else {
+        for (size_t i = 0; i < b.array.size(); i = i + 1) {
+            a.bits[b.array[i] >> 6] |= uint64_t(1) << (b.array[i] & 63);
+        }
+        for (size_t w = 0; w < BITSET_WORDS; w = w + 1) {
+            count = count + __builtin_popcountll(a.bits[w]);
+        }
+    }
+    a.count = count;
+    shrink(a);
+}
+
+// a = a AND NOT b (same key)
+void RoaringBitmap::subtractContainers(Container& a, const Container& b) {
+    if (a.isBitset()) {
+        uint32_t count = 0;
+        if (b.isBitset()) {
+            for (size_t w = 0; w < BITSET_WORDS; w = w + 1) {
+                a.bits[w] = a.bits[w] & ~b.bits[w];
+                count = count + __builtin_popcountll(a.bits[w]);
+            }
+        } else {
+            for (size_t i = 0; i < b.array.size(); i = i + 1) {
+                a.bits[b.array[i] >> 6] &= ~(uint64_t(1) << (b.array[i] & 63));
+            }
+            for (size_t w = 0; w < BITSET_WORDS; w = w + 1) {
+                count = count + __builtin_popcountll(a.bits[w]);
+            }
+        }
+        a.count = count;
+        shrink(a);
+    } else if (b.isBitset()) {
+        size_t kept = 0;
+        for (size_t i = 0; i < a.array.size(); i = i + 1) {
+            if (!((b.bits[a.array[i] >> 6] >> (a.array[i] & 63)) & 1)) {
+                a.array[kept] = a.array[i];
+                kept = kept + 1;
+            }
+        }
+        a.array.resize(kept);
+        a.count = static_cast<uint32_t>(kept);
+    } else {
+        vector<uint16_t> only;
+        set_difference(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), back_inserter(only));
+        a.array.swap(only);
+        a.count = static_cast<uint32_t>(a.array.size());
+    }
+}
+
+// Containers are matched up by key with a merge walk (both lists are sorted)
+void RoaringBitmap::intersectWith(const RoaringBitmap& other) {
+    vector<Container> result;
+    size_t j = 0;
+    for (size_t i = 0; i < containers.size(); i = i + 1) {
+        while (j < other.containers.size() && other.containers[j].key < containers[i].key) j = j + 1;
+        if (j == other.containers.size()) break;
+        if (other.containers[j].key != containers[i].key) continue;
+        intersectContainers(containers[i], other.containers[j]);
+        if (containers[i].count > 0) result.push_back(move(containers[i]));
+    }
+    containers.swap(result);
+}
+
+void RoaringBitmap::unionWith(const RoaringBitmap& other) {
+    vector<Container> result;
+    size_t i = 0, j = 0;
+    while (i < containers.size() || j < other.containers.size()) {
+        if (j == other.containers.size() || (i < containers.size() && containers[i].key < other.containers[j].key)) {
+            result.push_back(move(containers[i]));
+            i = i + 1;
+        } else if (i == containers.size() || other.containers[j].key < containers[i].key) {
+            result.push_back(other.containers[j]);
+            j = j + 1;
+        } else {
+            unionContainers(containers[i], other.containers[j]);
+            result.push_back(move(containers[i]));
+            i = i + 1;
+            j = j + 1;
+        }
+    }
+    containers.swap(result);
+}
+
+void RoaringBitmap::subtract(const RoaringBitmap& other) {
+    vector<Container> result;
+    size_t j = 0;
+    for (size_t i = 0; i < containers.size(); i = i + 1) {
+        while (j < other.containers.size() && other.containers[j].key < containers[i].key) j = j + 1;
+        if (j < other.containers.size() && other.containers[j].key == containers[i].key) {
+            subtractContainers(containers[i], other.containers[j]);
+        }
+        if (containers[i].count > 0) result.push_back(move(containers[i]));
+    }
+    containers.swap(result);
+}
+
+vector<uint32_t> RoaringBitmap::values() const {
+    vector<uint32_t> all;
+    all.reserve(cardinality());
+    for (size_t i = 0; i < containers.size(); i = i + 1) {
+        const Container& c = containers[i];
+        uint32_t high = static_cast<uint32_t>(c.key) << 16;
+        if (!c.isBitset()) {
+            for (size_t k = 0; k < c.array.size(); k = k + 1) all.push_back(high | c.array[k]);
+            continue;
+        }
+        for (size_t w = 0; w < BITSET_WORDS; w = w + 1) {
+            uint64_t word = c.bits[w];
+            while (word != 0) {
+                all.push_back(high | static_cast<uint32_t>(w * 64 + __builtin_ctzll(word)));
+                word = word & (word - 1);
+            }
+        }
+    }
+    return all;
+}
@@ -0,0 +1,188 @@
+#include "table_renderer.h"
+#include "event.h"
+#include <charconv>
+
+// ========================================
+// TABLE_RENDERER.CPP - Buffered Table Output
+// ========================================
+// This file prints tables (mainly the event list) without flushing the terminal on every row.
+// Rows are formatted into a std::string with to_chars (no iostream formatting state),
+// and the whole page is written with a single write + flush.
+// Demonstrates: Output buffering, std::to_chars, simple paging
+
+// Buffers grow to about this size before we write them out even in the middle of a page
+static const size_t FLUSH_THRESHOLD = 1 << 20;    // 1 MB
+
+// Paging settings (see setPaging)
+static size_t pageLimit = 0;
+static size_t startPage = 1;
+
+// Constructor - remember the layout and reserve room for a screenful of rows
+TableRenderer::TableRenderer(ostream& output, const vector<TableColumn>& tableColumns, size_t ruleWidth)
+    : out(output), columns(tableColumns), ruleLength(ruleWidth), cellIndex(0) {
+    buffer.reserve(64 * 1024);
+}
+
+// Destructor - never lose buffered rows
+TableRenderer::~TableRenderer() {
+    flush();
+}
+
+// Add text, padded with spaces on the right up to 'width' (longer text is not cut)
+void TableRenderer::appendPadded(string_view text, size_t width) {
+    buffer.append(text.data(), text.size());
+    if (text.size() < width) buffer.append(width - text.size(), ' ');
+}
+
+// Column titles between two rules; the "#" column lines up with " 1." row numbers
+void TableRenderer::header() {
+    buffer += '\n';
+    rule();
+    buffer += "  ";
+    appendPadded("#", 2);
+    buffer += "  ";
+    for (size_t i = 0; i < columns.size(); i = i + 1) {
+        if (i > 0) buffer += " | ";
+        if (i + 1 < columns.size()) {
+            appendPadded(columns[i].title, columns[i].width);
+        } else {
+            buffer += columns[i].title;
+        }
+    }
+    buffer += '\n';
+    rule();
+}
+
+void TableRenderer::rule() {
+    buffer.append(ruleLength, '=');
+    buffer += '\n';
+}
+
+void TableRenderer::line(string_view text) {
+    buffer.append(text.data(), text.size());
+    buffer += '\n';
+}
+
+// Start a row: two spaces, then the row number right-aligned in 2 characters and ". "
+void TableRenderer::beginRow(int index) {
+    buffer += "  ";
+    if (index > 0) {
+        char digits[16];
+        auto result = to_chars(digits, digits + sizeof(digits), index);
+        size_t length = static_cast<size_t>(result.ptr - digits);
+        if (length < 2) buffer.append(2 - length, ' ');
+        buffer.append(digits, length);
+        buffer += ". ";
+    }
+    cellIndex = 0;
+}
+
+// Add the next cell, with a " | " separator before every cell except the first
+void TableRenderer::cell(string_view text) {
+    if (cellIndex > 0) buffer += " | ";
+    if (cellIndex + 1 < columns.size()) {
+        appendPadded(text, columns[cellIndex].width);
+    } else {
+        buffer.append(text.data(), text.size());
+    }
+    cellIndex = cellIndex + 1;
+}
+
+// Numbers go through to_chars (fast, locale-free) and then behave like text cells
+void TableRenderer::cell(long long number) {
+    char digits[24];
+    auto result = to_chars(digits, digits + sizeof(digits), number);
+    cell(string_view(digits, static_cast<size_t>(result.ptr - digits)));
+}
+
+// Finish the row; very large pages are written out in 1 MB pieces (without flushing)
+void TableRenderer::endRow() {
+    buffer += '\n';
+    if (buffer.size() >= FLUSH_THRESHOLD) {
+        out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+        buffer.clear();
+    }
+}
+
+// Write the whole buffer in one go and flush once
+void TableRenderer::flush() {
+    if (!buffer.empty()) {
+        out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+        buffer.clear();
+    }
+    out.flush();
+}
+
+// Paging configuration
+void TableRenderer::setPaging(size_t page, size_t limit) {
+    startPage = (page == 0) ? 1 : page;
+    pageLimit = limit;
+}
+
+size_t TableRenderer::getPageLimit() {
+    return pageLimit;
+}
+
+size_t TableRenderer::getStartPage() {
+    return startPage;
+}
+
+// ==================== EVENT TABLE ====================
+
+// The layout that used to be copied into admin.cpp and student.cpp four times
+const vector<TableColumn>& eventTableColumns() {
+    static const vector<TableColumn> columns = {
+        { "EVENT NAME", 25 },
+        { "DATE", 12 },
+        { "VENUE", 20 },
+        { "CAP", 4 },
+        { "REG", 4 },
+        { "AVL", 0 }
+    };
+    return columns;
+}
+
+// Print the event table
+// What it does: Without --limit, prints every row and flushes once.
+// With --limit N, prints N rows per page (starting at --page), flushes after each page
+// and asks before showing the next one.
+void renderEventTable(ostream& out, const vector<const Event*>& rows) {
+    TableRenderer table(out, eventTableColumns(), 110);
+
+    size_t limit = TableRenderer::getPageLimit();
+    size_t total = rows.size();
+    size_t pageCount = (limit == 0 || total == 0) ? 1 : (total + limit - 1) / limit;
+    size_t page = min(TableRenderer::getStartPage(), pageCount);
+
+    while (page <= pageCount) {
+        size_t first = (limit == 0) ? 0 : (page - 1) * limit;
+        size_t last = (limit == 0) ? total : min(total, first + limit);
+
+        table.header();
+        for (size_t i = first; i < last; i = i + 1) {
+            rows[i]->appendTableRow(table, static_cast<int>(i + 1));
+        }
+        table.rule();
+        if (limit > 0) {
+            table.line("Page " + to_string(page) + " of " + to_string(pageCount) + " (rows "
+                       + to_string(first + 1) + "-" + to_string(last) + " of " + to_string(total) + ")");
+        }
+        table.flush();
+
+        if (page == pageCount) break;
+        out << "Press Enter for the next page (q to stop): " << flush;
+        string answer;
+        if (!getline(cin, answer) || answer == "q" || answer == "Q") break;
+        page = page + 1;
+    }
+}
+
+// Same, for a whole events table
+void renderEventTable(ostream& out, const vector<Event>& events) {
+    vector<const Event*> rows;
+    rows.reserve(events.size());
+    for (size_t i = 0; i < events.size(); i = i + 1) {
+        rows.push_back(&events[i]);
+    }
+    renderEventTable(out, rows);
+}
@@ -0,0 +1,146 @@
+#include "thread_pool.h"
+#include "metrics.h"
+
+// ========================================
+// THREAD_POOL.CPP - Work-Stealing Thread Pool
+// ========================================
+// This file implements a thread pool where each worker owns a deque of tasks.
+// Workers run their own tasks first (newest first, which is cache friendly)
+// and steal the oldest task from a busy neighbour when they run out.
+// Demonstrates: std::thread, mutex, condition_variable, atomics, work stealing
+
+// Index of the pool worker running on this thread (-1 for threads outside the pool)
+static thread_local long currentWorker = -1;
+
+// Get the shared pool
+// What it does: Creates one pool with a thread per CPU core the first time it's needed
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool(thread::hardware_concurrency() > 0 ? thread::hardware_concurrency() : 2);
+    return pool;
+}
+
+// Constructor - create one deque per worker, then start the workers
+ThreadPool::ThreadPool(size_t threadCount) : queued(0), nextQueue(0), stopping(false) {
+    if (threadCount == 0) threadCount = 1;
+    for (size_t i = 0; i < threadCount; i = i + 1) {
+        queues.push_back(unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+    for (size_t i = 0; i < threadCount; i = i + 1) {
+        workers.push_back(thread(&ThreadPool::workerLoop, this, i));
+    }
+}
+
+// Destructor - let the workers finish queued tasks, then join them
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(stateMutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (size_t i = 0; i < workers.size(); i = i + 1) {
+        workers[i].join();
+    }
+}
+
+// Add a task
+// Tasks submitted by a worker stay on that worker's deque (they often share data with it);
+// tasks from other threads are spread round-robin across all deques
+void ThreadPool::submit(function<void()> task) {
+    size_t target;
+    if (currentWorker >= 0 && static_cast<size_t>(currentWorker) < queues.size()) {
+        target = static_cast<size_t>(currentWorker);
+    } else {
+        target = nextQueue.fetch_add(1) % queues.size();
+    }
+
+    // Counted before the push, so a worker that takes the task at once can never bring
+    // the count below zero; counted under stateMutex so a worker about to sleep can't miss it
+    {
+        lock_guard<mutex> lock(stateMutex);
+        queued.fetch_add(1);
+    }
+    {
+        lock_guard<mutex> lock(queues[target]->queueMutex);
+        queues[target]->tasks.push_back(move(task));
+    }
+    taskAvailable.notify_one();
+}
+
+size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+// Find the next task for worker 'self'
+// What it does: Pops from the back of our own deque, otherwise steals from the front of another
+bool ThreadPool::takeTask(size_t self, function<void()>& task) {
+    {
+        WorkerQueue& own = *queues[self];
+        lock_guard<mutex> lock(own.queueMutex);
+        if (!own.tasks.empty()) {
+            task = move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    for (size_t offset = 1; offset < queues.size(); offset = offset + 1) {
+        WorkerQueue& victim = *queues[(self + offset) % queues.size()];
+        lock_guard<mutex> lock(victim.queueMutex);
+        if (!victim.tasks.empty()) {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+// What each worker thread does: run tasks while there are any, sleep when there are none
+void ThreadPool::workerLoop(size_t index) {
+    currentWorker = static_cast<long>(index);
+    while (true) {
+        function<void()> task;
+        if (takeTask(index, task)) {
+            task();
+            continue;
+        }
+
+        // A task counted but not pushed yet wakes us early; the next takeTask() finds it
+        unique_lock<mutex> lock(stateMutex);
+        taskAvailable.wait(lock, [this]() { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
+
+// Constructor - an empty group on 'pool'
+TaskGroup::TaskGroup(ThreadPool& pool) : pool(pool), remaining(0) {}
+
+TaskGroup::~TaskGroup() {
+    wait();
+}
+
+// Count the task, then hand the pool a wrapper that uncounts it when it finishes
+// The task's allocations are charged to the operation that submitted it (metrics.h)
+void TaskGroup::submit(function<void()> task) {
+    {
+        lock_guard<mutex> lock(countMutex);
+        remaining = remaining + 1;
+    }
+    OperationScope* owner = currentOperation();
+    pool.submit([this, task, owner]() {
+        {
+            WorkerScope charge(owner);
+            task();
+        }
+        lock_guard<mutex> lock(countMutex);
+        remaining = remaining - 1;
+        if (remaining == 0) allDone.notify_all();
+    });
+}
+
+void TaskGroup::wait() {
+    unique_lock<mutex> lock(countMutex);
+    allDone.wait(lock, [this]() { return remaining == 0; });
+}
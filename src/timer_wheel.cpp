@@ -0,0 +1,127 @@
+#include "timer_wheel.h"
+
+// ========================================
+// TIMER_WHEEL.CPP - Hierarchical Timing Wheel
+// ========================================
+// This file implements the timers behind seat holds. Each pending timer sits in exactly
+// one slot; advancing the clock only visits the slots whose time has come, so expiring
+// holds costs the same with ten pending holds or ten million.
+// Demonstrates: Timing wheels, intrusive linked lists in a vector, bit arithmetic
+
+TimerWheel::TimerWheel(long long startTick) : now(startTick), count(0) {
+    for (int l = 0; l < LEVELS; l = l + 1) {
+        for (int s = 0; s < SLOTS; s = s + 1) {
+            heads[l][s] = -1;
+        }
+    }
+}
+
+// Add a timer
+size_t TimerWheel::schedule(unsigned long long key, long long deadline) {
+    size_t handle;
+    if (!freeTimers.empty()) {
+        handle = freeTimers.back();
+        freeTimers.pop_back();
+    } else {
+        handle = timers.size();
+        timers.push_back(Timer());
+    }
+    timers[handle].key = key;
+    timers[handle].deadline = deadline > now ? deadline : now + 1;
+    place(handle);
+    count = count + 1;
+    return handle;
+}
+
+void TimerWheel::cancel(size_t handle) {
+    if (handle >= timers.size() || timers[handle].level < 0) return;
+    unlink(handle);
+    freeTimers.push_back(handle);
+    count = count - 1;
+}
+
+// Put a timer into the slot for its deadline
+// What it does: Picks the lowest wheel whose span still reaches the deadline, i.e. the first
+// level at which the deadline and the current tick agree on every higher digit (base 64).
+// Deadlines beyond the last wheel wait in its furthest slot and are placed again later.
+void TimerWheel::place(size_t handle) {
+    Timer& timer = timers[handle];
+    long long due = timer.deadline;
+    long long reach = static_cast<long long>(SLOTS - 1) << (SLOT_BITS * (LEVELS - 1));
+    if (due - now > reach) due = now + reach;
+
+    int level = 0;
+    while (level < LEVELS - 1 && (due >> (SLOT_BITS * (level + 1))) != (now >> (SLOT_BITS * (level + 1)))) {
+        level = level + 1;
+    }
+    int slot = static_cast<int>((due >> (SLOT_BITS * level)) & (SLOTS - 1));
+
+    timer.level = level;
+    timer.slot = slot;
+    timer.prev = -1;
+    timer.next = heads[level][slot];
+    if (timer.next >= 0) timers[timer.next].prev = static_cast<long long>(handle);
+    heads[level][slot] = static_cast<long long>(handle);
+}
+
+void TimerWheel::unlink(size_t handle) {
+    Timer& timer = timers[handle];
+    if (timer.prev >= 0) timers[timer.prev].next = timer.next;
+    else heads[timer.level][timer.slot] = timer.next;
+    if (timer.next >= 0) timers[timer.next].prev = timer.prev;
+    timer.level = -1;
+    timer.prev = -1;
+    timer.next = -1;
+}
+
+// Move the clock forward one tick at a time
+// What it does: When a wheel comes round to slot 0, the next slot of the wheel above is
+// emptied and its timers are placed again (they now fit a lower wheel); this is done from
+// the top wheel down so a timer can drop several wheels in one tick. Then every timer in
+// the first wheel's slot for this tick fires. With nothing pending the clock just jumps.
+void TimerWheel::advance(long long target, vector<unsigned long long>& fired) {
+    while (now < target) {
+        if (count == 0) {
+            now = target;
+            break;
+        }
+        now = now + 1;
+
+        for (int level = LEVELS - 1; level >= 1; level = level - 1) {
+            if ((now & ((1LL << (SLOT_BITS * level)) - 1)) != 0) continue;
+            int slot = static_cast<int>((now >> (SLOT_BITS * level)) & (SLOTS - 1));
+            long long handle = heads[level][slot];
+            heads[level][slot] = -1;
+            while (handle >= 0) {
+                long long next = timers[handle].next;
+                place(static_cast<size_t>(handle));
+                handle = next;
+            }
+        }
+
+        int slot = static_cast<int>(now & (SLOTS - 1));
+        long long handle = heads[0][slot];
+        heads[0][slot] = -1;
+        while (handle >= 0) {
+            long long next = timers[handle].next;
+            Timer& timer = timers[handle];
+            timer.level = -1;
+            if (timer.deadline > now) {
+                place(static_cast<size_t>(handle));    // Was parked in the last wheel's furthest slot
+            } else {
+                fired.push_back(timer.key);
+                freeTimers.push_back(static_cast<size_t>(handle));
+                count = count - 1;
+            }
+            handle = next;
+        }
+    }
+}
+
+long long TimerWheel::currentTick() const {
+    return now;
+}
+
+size_t TimerWheel::pending() const {
+    return count;
+}
@@ -1,4 +1,5 @@
 #include "utils.h"
+#include <ctime>
 
 // ========================================
 // UTILS.CPP - Utility Functions Implementation
@@ -92,6 +93,16 @@ bool isValidDate(const string& date) {
     return true;    // All validations passed
 }
 
+// Check time format (HH:MM)
+// What it does: Accepts 00:00 to 23:59 with exactly two digits for hours and minutes
+bool isValidTime(const string& time) {
+    if (time.length() != 5 || time[2] != ':') return false;
+    string hours = time.substr(0, 2);
+    string minutes = time.substr(3, 2);
+    if (!isNumeric(hours) || !isNumeric(minutes)) return false;
+    return stoi(hours) < 24 && stoi(minutes) < 60;
+}
+
 // Convert string to lowercase
 // What it does: Converts all uppercase letters in a string to lowercase
 // Example: "Hello World" → "hello world"
@@ -106,3 +117,16 @@ string toLower(const string& str) {
     
     return result;          // Return the lowercase version
 }
+
+// Get current date and time
+// What it does: Returns current system date/time as a formatted string
+// Used when: Recording when a student registered (or was promoted from a waitlist)
+// Returns: String in format "DD-MM-YYYY HH:MM"
+string currentDateTime() {
+    time_t now = time(0);                  // Get current time as seconds since epoch
+    tm* timeinfo = localtime(&now);         // Convert to local time structure
+    char buffer[20];                        // Character array to hold formatted string
+    // strftime formats the time according to the format string
+    strftime(buffer, sizeof(buffer), "%d-%m-%Y %H:%M", timeinfo);
+    return string(buffer);                  // Convert char array to string
+}
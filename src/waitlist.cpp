@@ -0,0 +1,178 @@
+#include "waitlist.h"
+#include <algorithm>
+
+// ========================================
+// WAITLIST.CPP - Per-Event Waitlists
+// ========================================
+// This file keeps the students waiting for seats in full events.
+// Each event's waitlist is a max-heap ordered by (priority, then earliest join),
+// so finding the next student to promote costs O(log n) instead of scanning the list.
+// Demonstrates: Binary heaps (push_heap/pop_heap), lazy deletion, hash maps
+
+// Heap order: "a comes after b" → a has lower priority, or same priority but joined later
+static bool promotedLater(const WaitlistEntry& a, const WaitlistEntry& b) {
+    if (a.priority != b.priority) return a.priority < b.priority;
+    return a.sequence > b.sequence;
+}
+
+// Format for registrations.txt
+// Example: "bob|Tech Fest 2025|12-11-2025 09:30|WAITLIST|0|17"
+string WaitlistEntry::toFileFormat() const {
+    return username + "|" + eventName + "|" + joinDate + "|WAITLIST|" +
+           to_string(priority) + "|" + to_string(sequence);
+}
+
+Waitlist::Waitlist() : highestSequence(0) {}
+
+// Lookup key for one student on one event
+string Waitlist::key(const string& username, const string& eventName) {
+    return username + "|" + eventName;
+}
+
+// An entry is live if it is the one currently registered under its key
+// (a student who left and joined again leaves a dead copy behind in the heap)
+bool Waitlist::isLive(const WaitlistEntry& entry) const {
+    auto found = live.find(key(entry.username, entry.eventName));
+    return found != live.end() && found->second == entry.sequence;
+}
+
+// Drop one entry from a student's list (it left, was promoted or its event went away)
+void Waitlist::forgetUserEntry(const string& username, const string& eventName) {
+    auto mine = byUser.find(username);
+    if (mine == byUser.end()) return;
+    vector<WaitlistEntry>& entries = mine->second;
+    for (size_t i = 0; i < entries.size(); i = i + 1) {
+        if (entries[i].eventName == eventName) {
+            entries.erase(entries.begin() + i);
+            break;
+        }
+    }
+    if (entries.empty()) byUser.erase(mine);
+}
+
+// Add a student to the waitlist
+bool Waitlist::join(const WaitlistEntry& entry) {
+    string k = key(entry.username, entry.eventName);
+    if (live.count(k) > 0) return false;
+
+    vector<WaitlistEntry>& heap = heaps[entry.eventName];
+    heap.push_back(entry);
+    push_heap(heap.begin(), heap.end(), promotedLater);
+
+    live[k] = entry.sequence;
+    counts[entry.eventName] = counts[entry.eventName] + 1;
+    byUser[entry.username].push_back(entry);
+    if (entry.sequence > highestSequence) highestSequence = entry.sequence;
+    return true;
+}
+
+// Leave the waitlist (lazy: the heap entry stays until it reaches the top)
+bool Waitlist::leave(const string& username, const string& eventName) {
+    if (live.erase(key(username, eventName)) == 0) return false;
+    counts[eventName] = counts[eventName] - 1;
+    forgetUserEntry(username, eventName);
+    return true;
+}
+
+bool Waitlist::contains(const string& username, const string& eventName) const {
+    return live.count(key(username, eventName)) > 0;
+}
+
+// Pop the next live entry for an event
+// Dead entries found on top of the heap are thrown away on the way
+bool Waitlist::popNext(const string& eventName, WaitlistEntry& next) {
+    auto found = heaps.find(eventName);
+    if (found == heaps.end()) return false;
+
+    vector<WaitlistEntry>& heap = found->second;
+    while (!heap.empty()) {
+        pop_heap(heap.begin(), heap.end(), promotedLater);
+        WaitlistEntry top = heap.back();
+        heap.pop_back();
+
+        if (isLive(top)) {
+            live.erase(key(top.username, top.eventName));
+            counts[eventName] = counts[eventName] - 1;
+            forgetUserEntry(top.username, eventName);
+            next = top;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t Waitlist::waitingCount(const string& eventName) const {
+    auto found = counts.find(eventName);
+    return found == counts.end() ? 0 : found->second;
+}
+
+// Forget an event's waitlist entirely
+void Waitlist::removeEvent(const string& eventName) {
+    auto found = heaps.find(eventName);
+    if (found == heaps.end()) return;
+
+    for (size_t i = 0; i < found->second.size(); i = i + 1) {
+        if (isLive(found->second[i])) {
+            live.erase(key(found->second[i].username, eventName));
+            forgetUserEntry(found->second[i].username, eventName);
+        }
+    }
+    heaps.erase(found);
+    counts.erase(eventName);
+}
+
+// Move an event's waitlist to its new name
+// What it does: Live entries are re-filed under the new name with their priority and
+// sequence unchanged, so the heap order (and everyone's place in line) stays the same.
+// Dead entries are left behind and dropped with the old name.
+void Waitlist::renameEvent(const string& oldName, const string& newName) {
+    if (oldName == newName) return;
+    auto found = heaps.find(oldName);
+    if (found == heaps.end()) return;
+    vector<WaitlistEntry> moving;
+    for (size_t i = 0; i < found->second.size(); i = i + 1) {
+        if (isLive(found->second[i])) moving.push_back(found->second[i]);
+    }
+    removeEvent(oldName);
+    for (size_t i = 0; i < moving.size(); i = i + 1) {
+        moving[i].eventName = newName;
+        join(moving[i]);    // Refused only if the student already waits under the new name
+    }
+}
+
+// All live entries sorted by join order (so the saved file reads chronologically)
+vector<WaitlistEntry> Waitlist::allEntries() const {
+    vector<WaitlistEntry> result;
+    for (const auto& heap : heaps) {
+        for (size_t i = 0; i < heap.second.size(); i = i + 1) {
+            if (isLive(heap.second[i])) result.push_back(heap.second[i]);
+        }
+    }
+    sort(result.begin(), result.end(), [](const WaitlistEntry& a, const WaitlistEntry& b) {
+        return a.sequence < b.sequence;
+    });
+    return result;
+}
+
+// One student's live entries, sorted by join order
+vector<WaitlistEntry> Waitlist::entriesForUser(const string& username) const {
+    auto mine = byUser.find(username);
+    if (mine == byUser.end()) return vector<WaitlistEntry>();
+    vector<WaitlistEntry> result = mine->second;
+    sort(result.begin(), result.end(), [](const WaitlistEntry& a, const WaitlistEntry& b) {
+        return a.sequence < b.sequence;
+    });
+    return result;
+}
+
+long long Waitlist::nextSequence() const {
+    return highestSequence + 1;
+}
+
+void Waitlist::clear() {
+    heaps.clear();
+    live.clear();
+    counts.clear();
+    byUser.clear();
+    highestSequence = 0;
+}
@@ -0,0 +1,422 @@
+#include "event_store.h"
+#include "durable_file.h"
+#include <iostream>
+#include <fstream>
+#include <functional>
+#include <cstdlib>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// ========================================
+// SESSION_TEST.CPP - Two Sessions Sharing data/
+// ========================================
+// This file runs the situations where two sessions (two processes, each with its own
+// EventStore) change the same data at the same time, and checks that each one sees the
+// other's changes before deciding. Every scenario starts from fresh data files in a
+// temporary directory; each session is a forked child, and the parent only compares what
+// the children report.
+// Build and run: make test
+// Demonstrates: fork/waitpid, pipes as start signals, multi-process testing
+
+static int failures = 0;
+static vector<string> scenarioDirs;    // Removed when the run ends
+
+static void check(bool ok, const string& what) {
+    cout << (ok ? "PASS: " : "FAIL: ") << what << endl;
+    if (!ok) failures = failures + 1;
+}
+
+// Start a scenario in a new temporary directory with these data files
+static void freshData(const string& events, const string& venues) {
+    char dir[] = "/tmp/event-session-test-XXXXXX";
+    if (mkdtemp(dir) == nullptr || chdir(dir) != 0 || mkdir("data", 0755) != 0) {
+        cout << "Error: Could not create a test directory!" << endl;
+        exit(1);
+    }
+    scenarioDirs.push_back(dir);
+    ofstream("data/events.txt") << events;
+    ofstream("data/registrations.txt") << "";
+    if (!venues.empty()) ofstream("data/venues.txt") << venues;
+}
+
+// One session: a child process that runs 'body' and exits with its result (0-255)
+static pid_t startSession(const function<int()>& body) {
+    cout.flush();
+    pid_t pid = fork();
+    if (pid == 0) {
+        int result = body();
+        cout.flush();
+        _exit(result);
+    }
+    return pid;
+}
+
+static int sessionResult(pid_t pid) {
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+// A start signal: sessions block in wait() until the parent calls open()
+struct Gate {
+    int fds[2];
+    Gate() {
+        if (pipe(fds) != 0) exit(1);
+    }
+    void wait() {
+        close(fds[1]);
+        char byte;
+        while (read(fds[0], &byte, 1) > 0) {}
+    }
+    void open() {
+        close(fds[0]);
+        close(fds[1]);
+    }
+};
+
+// Both sessions have the event loaded while it still has one free seat, then both ask for it
+static void lastSeatGoesToOneSession() {
+    freshData("Tiny Talk|01-12-2030|Room 1|1|0\n", "");
+    Gate go;
+    auto admit = [&go](const string& username) {
+        return [&go, username]() {
+            EventStore& store = EventStore::instance();
+            store.getEvents();
+            store.getRegistrations();
+            go.wait();
+            return store.admitBatch("Tiny Talk", vector<SeatRequest>(1, SeatRequest{ username, "01-11-2030 10:00" }))[0]
+                .granted ? 1 : 0;
+        };
+    };
+    pid_t alice = startSession(admit("alice"));
+    pid_t bob = startSession(admit("bob"));
+    sleep(1);    // Both sessions load before either one admits
+    go.open();
+    int granted = sessionResult(alice) + sessionResult(bob);
+    check(granted == 1, "the last seat is granted to exactly one of two racing sessions");
+
+    int registered = sessionResult(startSession([]() {
+        return static_cast<int>(EventStore::instance().getRegistrations().size());
+    }));
+    check(registered == 1, "a third session reads back one registration");
+}
+
+// The held count of one event as a fresh session sees it (99 if the event is missing)
+// Holds are kept with the registrations, so both tables are loaded, as any registration does
+static int heldSeatsOf(const string& eventName) {
+    return sessionResult(startSession([eventName]() {
+        EventStore& store = EventStore::instance();
+        store.getRegistrations();
+        const vector<Event>& events = store.getEvents();
+        for (size_t i = 0; i < events.size(); i = i + 1) {
+            if (events[i].getEventName() == eventName) return events[i].getHeldSeats();
+        }
+        return 99;
+    }));
+}
+
+// One session holds the only seat; a session that loaded before the hold must not get it
+static void holdIsSeenByOtherSessions() {
+    freshData("Tiny Talk|01-12-2030|Room 1|1|0\n", "");
+    Gate held;
+    pid_t other = startSession([&held]() {
+        EventStore& store = EventStore::instance();
+        store.getEvents();
+        store.getRegistrations();
+        held.wait();
+        string problem;
+        bool holdRefused = !store.holdSeat("bob", "Tiny Talk", 10, problem) && problem == "Event is full";
+        bool registrationRefused =
+            !store.admitBatch("Tiny Talk", vector<SeatRequest>(1, SeatRequest{ "bob", "01-11-2030 10:00" }))[0].granted;
+        return (holdRefused ? 1 : 0) + (registrationRefused ? 2 : 0);
+    });
+    int holder = sessionResult(startSession([]() {
+        string problem;
+        return EventStore::instance().holdSeat("alice", "Tiny Talk", 10, problem) ? 1 : 0;
+    }));
+    check(holder == 1, "the first session holds the only seat");
+    held.open();
+    int refused = sessionResult(other);
+    check((refused & 1) != 0, "a second session can't hold the seat the first one holds");
+    check((refused & 2) != 0, "a second session can't register into the seat the first one holds");
+    check(heldSeatsOf("Tiny Talk") == 1, "a new session sees the seat as held");
+
+    int confirmed = sessionResult(startSession([]() {
+        EventStore& store = EventStore::instance();
+        return store.admitBatch("Tiny Talk", vector<SeatRequest>(1, SeatRequest{ "alice", "01-11-2030 10:01" }))[0]
+            .granted ? 1 : 0;
+    }));
+    check(confirmed == 1, "the holder registers from another session using the hold");
+    check(heldSeatsOf("Tiny Talk") == 0, "registering ends the hold in every session");
+
+    int checkpointed = sessionResult(startSession([]() {
+        string problem;
+        EventStore& store = EventStore::instance();
+        Event event("Big Talk", "02-12-2030", "Room 2", 5, 0);
+        bool ok = store.addEvent(event) && store.holdSeat("carol", "Big Talk", 10, problem) &&
+                  store.checkpoint(true);
+        return ok ? 1 : 0;
+    }));
+    check(checkpointed == 1, "a hold is written into a checkpoint");
+    check(heldSeatsOf("Big Talk") == 1, "a hold is read back from registrations.txt");
+}
+
+// Two sessions register different students for a numbered-seat event at the same moment
+static void racingSessionsGetDifferentSeats() {
+    freshData("Seated Talk|03-12-2030|Small Hall|6|0\n", "Small Hall|2|3\n");
+    Gate go;
+    auto registerFor = [&go](const string& username) {
+        return [&go, username]() {
+            EventStore& store = EventStore::instance();
+            store.getEvents();
+            store.getRegistrations();
+            go.wait();
+            vector<string> problems;
+            return store.registerBatch(username, vector<size_t>(1, 0), "01-11-2030 10:00", problems) ? 1 : 0;
+        };
+    };
+    pid_t alice = startSession(registerFor("alice"));
+    pid_t bob = startSession(registerFor("bob"));
+    sleep(1);
+    go.open();
+    int registered = sessionResult(alice) + sessionResult(bob);
+    check(registered == 2, "both racing sessions register");
+
+    int seats = sessionResult(startSession([]() {
+        const vector<Registration>& all = EventStore::instance().getRegistrations();
+        if (all.size() != 2 || all[0].getSeat().empty()) return 0;
+        return all[0].getSeat() != all[1].getSeat() ? 1 : 0;
+    }));
+    check(seats == 1, "racing sessions are given different seats");
+}
+
+// Two sessions add an event with the same name at the same moment; one of them deletes an event
+// the other has already deleted
+static void racingSessionsAddOneEvent() {
+    freshData("Old Talk|01-12-2030|Room 1|5|0\n", "");
+    Gate go;
+    auto addAndRemove = [&go](const string& name) {
+        return [&go, name]() {
+            EventStore& store = EventStore::instance();
+            store.getEvents();
+            store.getRegistrations();
+            go.wait();
+            bool added = store.addEvent(Event(name, "02-12-2030", "Room 2", 5, 0));
+            bool removed = store.removeEvent(0);
+            return (added ? 1 : 0) + (removed ? 2 : 0);
+        };
+    };
+    pid_t alice = startSession(addAndRemove("New Talk"));
+    pid_t bob = startSession(addAndRemove("new talk"));
+    sleep(1);
+    go.open();
+    int first = sessionResult(alice);
+    int second = sessionResult(bob);
+    check((first & 1) + (second & 1) == 1, "only one of two sessions adding the same name succeeds");
+    check((first & 2) + (second & 2) == 2, "only one of two sessions deleting the same event succeeds");
+
+    int events = sessionResult(startSession([]() {
+        return static_cast<int>(EventStore::instance().getEvents().size());
+    }));
+    check(events == 1, "a third session reads back just the added event");
+}
+
+// A session lowers the capacity of an event that another session has filled meanwhile
+static void capacityEditSeesOtherSessionsSeats() {
+    freshData("Tiny Talk|01-12-2030|Room 1|5|0\n", "");
+    Gate go;
+    pid_t editor = startSession([&go]() {
+        EventStore& store = EventStore::instance();
+        store.getEvents();
+        store.getRegistrations();
+        go.wait();
+        Event smaller = store.getEvents()[0];    // Still shows 0 registered
+        smaller.setCapacity(2);
+        string problem;
+        return store.updateEvent(0, smaller, nullptr, &problem) ? 0 : (problem.empty() ? 1 : 2);
+    });
+    int registered = sessionResult(startSession([]() {
+        EventStore& store = EventStore::instance();
+        vector<string> usernames = { "alice", "bob", "carol" };
+        int granted = 0;
+        for (size_t i = 0; i < usernames.size(); i = i + 1) {
+            SeatRequest request{ usernames[i], "01-11-2030 10:00" };
+            if (store.admitBatch("Tiny Talk", vector<SeatRequest>(1, request))[0].granted) granted = granted + 1;
+        }
+        return granted;
+    }));
+    go.open();
+    check(registered == 3 && sessionResult(editor) == 2,
+          "a capacity below the seats another session has taken is refused, with a reason");
+}
+
+// Waitlist changes are decided against other sessions' registrations and seats
+static void waitlistFollowsOtherSessions() {
+    freshData("Tiny Talk|01-12-2030|Room 1|2|2\n", "");
+    ofstream("data/registrations.txt") << "alice|Tiny Talk|01-11-2030 10:00\n"
+                                          "dave|Tiny Talk|01-11-2030 10:00\n"
+                                          "dave|Tiny Talk|01-11-2030 09:00|WAITLIST|0|1\n"    // Registered and waiting
+                                          "erin|Tiny Talk|01-11-2030 09:30|WAITLIST|0|2\n";
+    Gate go;
+    pid_t carol = startSession([&go]() {
+        EventStore& store = EventStore::instance();
+        store.getEvents();
+        store.getRegistrations();    // The event is full when this session loads
+        go.wait();
+        string problem;
+        return store.joinWaitlist("carol", 0, "01-11-2030 11:00", 0, &problem) ? 0 : (problem.empty() ? 1 : 2);
+    });
+
+    int promoted = sessionResult(startSession([]() {
+        vector<WaitlistEntry> promoted;
+        EventStore::instance().unregisterStudent("alice", "Tiny Talk", &promoted);
+        return promoted.size() == 1 && promoted[0].username == "erin" ? 1 : 0;
+    }));
+    check(promoted == 1, "promotion skips a waiting student who is registered already");
+
+    int raised = sessionResult(startSession([]() {
+        EventStore& store = EventStore::instance();
+        Event bigger = store.getEvents()[0];
+        bigger.setCapacity(3);
+        return store.updateEvent(0, bigger) ? 1 : 0;
+    }));
+    go.open();
+    check(raised == 1 && sessionResult(carol) == 2, "a session can't join the waitlist once another one freed a seat");
+
+    int registered = sessionResult(startSession([]() {
+        EventStore& store = EventStore::instance();
+        string problem;
+        bool joined = store.holdSeat("frank", "Tiny Talk", 10, problem) &&
+                      store.joinWaitlist("frank", 0, "01-11-2030 12:00");    // Full: frank holds the last seat
+        SeatRequest request{ "frank", "01-11-2030 12:01" };
+        return joined && store.admitBatch("Tiny Talk", vector<SeatRequest>(1, request))[0].granted ? 1 : 0;
+    }));
+    int waiting = sessionResult(startSession([]() {
+        return static_cast<int>(EventStore::instance().getWaitlist().waitingCount("Tiny Talk"));
+    }));
+    check(registered == 1 && waiting == 0, "registering takes the student off the waitlist in every session");
+}
+
+// A checkpoint planned before another session committed a newer one must not replace its files
+// (the parent plays the other session: it holds the checkpoint lock and writes newer files)
+static void olderCheckpointNeverReplacesNewer() {
+    freshData("Tiny Talk|01-12-2030|Room 1|1|0\n", "");
+    Gate go;
+    pid_t older = startSession([&go]() {
+        EventStore& store = EventStore::instance();
+        store.addEvent(Event("Big Talk", "02-12-2030", "Room 2", 5, 0));
+        go.wait();
+        return store.checkpoint(true) ? 1 : 0;
+    });
+    sleep(1);    // The session is loaded before the lock is taken
+    {
+        ExclusiveFileLock lock("data/checkpoint.lock");
+        go.open();
+        sleep(1);    // Its checkpoint is planned and waits for the lock
+        ofstream("data/events.txt") << "#checkpoint|99\nNewer Talk|01-12-2030|Room 1|5|0\n";
+        ofstream("data/registrations.txt") << "#checkpoint|99\n";
+    }
+    check(sessionResult(older) == 1, "a checkpoint that finds newer files reports nothing lost");
+
+    string header;
+    ifstream events("data/events.txt");
+    getline(events, header);
+    check(header == "#checkpoint|99", "an older checkpoint never replaces newer data files");
+
+    int rewritten = sessionResult(startSession([]() {
+        EventStore& store = EventStore::instance();
+        store.setFixedWidthEvents(true);
+        return store.checkpoint(true) ? 1 : 0;
+    }));
+    ifstream converted("data/events.txt");
+    getline(converted, header);
+    check(rewritten == 1 && header.find("fixed-width") != string::npos,
+          "a checkpoint with nothing new to fold in still rewrites the files it planned");
+}
+
+// A session that loads while a checkpoint is patching events.txt in place must wait for it:
+// rows that already hold the new seat count under the old header would be counted twice
+// (the parent plays the checkpoint, stopping half-way with the lock held)
+static void loadWaitsForAnInPlaceCheckpoint() {
+    freshData("Tiny Talk|01-12-2030|Room 1|5|0\n", "");
+    int registered = sessionResult(startSession([]() {
+        return EventStore::instance().admitBatch("Tiny Talk", vector<SeatRequest>(1, SeatRequest{ "alice", "01-11-2030 10:00" }))[0]
+            .granted ? 1 : 0;
+    }));
+    check(registered == 1, "a registration is journaled");
+
+    Gate go;
+    pid_t reader = startSession([&go]() {
+        EventStore& store = EventStore::instance();
+        go.wait();
+        const vector<Event>& events = store.getEvents();
+        return events.empty() ? 99 : events[0].getRegisteredCount();
+    });
+    sleep(1);    // The session exists before the lock is taken
+    {
+        ExclusiveFileLock lock("data/checkpoint.lock");
+        ofstream("data/events.txt") << "Tiny Talk|01-12-2030|Room 1|5|1\n";    // Row patched, header not yet
+        go.open();
+        sleep(1);
+        ofstream("data/events.txt") << "#checkpoint|1\nTiny Talk|01-12-2030|Room 1|5|1\n";
+    }
+    check(sessionResult(reader) == 1, "a session loading during a checkpoint counts each registration once");
+}
+
+// A rename by another session moves the event's registrations and the indexes built from them
+static void renameKeepsRegistrations() {
+    freshData("Tiny Talk|01-12-2030|Room 1|5|0\n", "");
+    Gate go;
+    pid_t reader = startSession([&go]() {
+        EventStore& store = EventStore::instance();
+        SeatRequest request{ "alice", "01-11-2030 10:00" };
+        store.admitBatch("Tiny Talk", vector<SeatRequest>(1, request));
+        store.studentsOf("Tiny Talk");    // Student sets built under the old name
+        go.wait();
+        store.refresh();
+        return store.isRegistered("alice", "Big Talk") && !store.isRegistered("alice", "Tiny Talk") &&
+               store.studentsOf("Big Talk").cardinality() == 1 && store.studentsOf("Tiny Talk").cardinality() == 0 ? 1 : 0;
+    });
+    sleep(1);    // The registration is journaled before the rename
+    int renamed = sessionResult(startSession([]() {
+        EventStore& store = EventStore::instance();
+        Event edited = store.getEvents()[0];
+        edited.setEventName("Big Talk");
+        return store.updateEvent(0, edited) ? 1 : 0;
+    }));
+    go.open();
+    check(renamed == 1 && sessionResult(reader) == 1, "another session's rename moves the event's registrations");
+
+    // A new session replays the rename from the journal, then folds it into the data files
+    int replayed = sessionResult(startSession([]() {
+        EventStore& store = EventStore::instance();
+        return store.isRegistered("alice", "Big Talk") && store.checkpoint(true) ? 1 : 0;
+    }));
+    int saved = sessionResult(startSession([]() {
+        const vector<Registration>& registrations = EventStore::instance().getRegistrations();
+        return registrations.size() == 1 && registrations[0].getEventName() == "Big Talk" ? 1 : 0;
+    }));
+    check(replayed == 1 && saved == 1, "a renamed event keeps its registrations in the data files");
+}
+
+int main() {
+    lastSeatGoesToOneSession();
+    holdIsSeenByOtherSessions();
+    racingSessionsGetDifferentSeats();
+    racingSessionsAddOneEvent();
+    capacityEditSeesOtherSessionsSeats();
+    waitlistFollowsOtherSessions();
+    olderCheckpointNeverReplacesNewer();
+    loadWaitsForAnInPlaceCheckpoint();
+    renameKeepsRegistrations();
+
+    if (chdir("/") == 0) {
+        for (size_t i = 0; i < scenarioDirs.size(); i = i + 1) {
+            if (system(("rm -rf " + scenarioDirs[i]).c_str()) != 0) cout << "Note: could not remove " << scenarioDirs[i] << endl;
+        }
+    }
+
+    cout << (failures == 0 ? "All session tests passed" : to_string(failures) + " session test(s) failed") << endl;
+    return failures == 0 ? 0 : 1;
+}